@@ -39,14 +39,18 @@ SOURCES = applock.cpp              \
           format.cpp \
           graphicstextbuttonitem.cpp \
           gunzip.cpp \
+          imagecache.cpp \
           login2.cpp \
+          metasqlcache.cpp \
           metrics.cpp \
           metricsenc.cpp \
+          notifycache.cpp \
           qbase64encode.cpp \
           qmd5.cpp \
           shortcuts.cpp \
           storedProcErrorLookup.cpp \
           tarfile.cpp \
+          urlstream.cpp \
           xabstractmessagehandler.cpp \
           xbase32.cpp \
           xtupleproductkey.cpp \
@@ -64,14 +68,18 @@ HEADERS = applock.h              \
           graphicstextbuttonitem.h \
           guimessagehandler.h \
           gunzip.h \
+          imagecache.h \
           login2.h \
+          metasqlcache.h \
           metrics.h \
           metricsenc.h \
+          notifycache.h \
           qbase64encode.h \
           qmd5.h \
           shortcuts.h \
           storedProcErrorLookup.h \
           tarfile.h \
+          urlstream.h \
           xabstractmessagehandler.h \
           xbase32.h \
           xtupleproductkey.h \
@@ -11,6 +11,8 @@
 #include "errorReporter.h"
 
 #include <QApplication>
+#include <QHash>
+#include <QList>
 #include <QMap>
 #include <QMessageBox>
 #include <QRegExp>
@@ -1266,12 +1268,19 @@ class ErrorReporterPrivate : public QObject
 
   private:
     ErrorReporter *_parent;
+    QHash<QString, QList<int> > _constraints; // constraint -> dberrs[] indices
 };
 
 ErrorReporterPrivate::ErrorReporterPrivate(ErrorReporter *parent)
   : QObject(parent)
 {
   _parent = parent;
+
+  for (int i = 0; i < (int)(sizeof(dberrs) / sizeof(dberrs[0])); i++)
+  {
+    if (dberrs[i].lookup || ! dberrs[i].msg.isEmpty())
+      _constraints[dberrs[i].constraint].append(i);
+  }
 }
 
 ErrorReporterPrivate::~ErrorReporterPrivate()
@@ -1294,7 +1303,11 @@ QString ErrorReporterPrivate::text(QSqlError err, StatementType type)
   return text(err.text(), type);
 }
 
-// TODO: find a better way to handle the lookups - binary search or hash table
+/* constraint names are identifiers, so rather than searching the message
+   for every constraint in dberrs[], split the message into identifier
+   tokens and look each one up. if several tokens name constraints, the
+   one listed first in dberrs[] wins.
+ */
 QString ErrorReporterPrivate::text(QString msg, StatementType type)
 {
   if (msg.isEmpty())
@@ -1308,18 +1321,38 @@ QString ErrorReporterPrivate::text(QString msg, StatementType type)
     return storedProcErrorLookup(_xtupleError.cap(1),
                                  _xtupleError.cap(2).toInt());
   }
-  else
+  else if (type != Unknown)
   {
-    for (unsigned int i = 0; i < sizeof(dberrs) / sizeof(dberrs[0]); i++)
+    int found = -1;
+    int start = -1;
+    for (int i = 0; i <= msg.length(); i++)
     {
-      if (dberrs[i].type & type && msg.contains(dberrs[i].constraint))
+      bool ident = i < msg.length() &&
+                   (msg.at(i).isLetterOrNumber() || msg.at(i) == QChar('_'));
+      if (ident && start < 0)
+        start = i;
+      else if (! ident && start >= 0)
       {
-        if (dberrs[i].lookup)
-          return storedProcErrorLookup(dberrs[i].msg, dberrs[i].lookup);
-        else if (! dberrs[i].msg.isEmpty())
-          return dberrs[i].msg;
+        QHash<QString, QList<int> >::const_iterator it =
+                                _constraints.constFind(msg.mid(start, i - start));
+        if (it != _constraints.constEnd())
+        {
+          foreach (int e, it.value())
+          {
+            if (dberrs[e].type & type && (found < 0 || e < found))
+              found = e;
+          }
+        }
+        start = -1;
       }
     }
+
+    if (found >= 0)
+    {
+      if (dberrs[found].lookup)
+        return storedProcErrorLookup(dberrs[found].msg, dberrs[found].lookup);
+      return dberrs[found].msg;
+    }
   }
 
   return msg;
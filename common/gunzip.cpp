@@ -13,6 +13,8 @@
 #include <zlib.h>
 #include <qbuffer.h>
 
+#define GUNZIPBUFSIZE (64 * 1024)
+
 QByteArray gunzipFile(const QString & file)
 {
   QByteArray data;
@@ -28,16 +30,16 @@ QByteArray gunzipFile(const QString & file)
     return data;
   }
 
-  char bytes[1024];
+  QByteArray bytes(GUNZIPBUFSIZE, '\0');
   int byte_count;
 
   while(!gzeof(fin))
   {
-    byte_count = gzread(fin, &bytes[0], 1024);
+    byte_count = gzread(fin, bytes.data(), bytes.size());
     if(byte_count == -1)
       break;
     if(byte_count > 0)
-      fout.write(&bytes[0], byte_count);
+      fout.write(bytes.constData(), byte_count);
   }
 
   fout.close();
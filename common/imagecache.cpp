@@ -0,0 +1,166 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "imagecache.h"
+
+#include <QObject>
+#include <QSqlError>
+#include <QVariant>
+
+#include <quuencode.h>
+
+#include "errorReporter.h"
+#include "xsqlquery.h"
+
+#define DEBUG false
+
+#define CACHESIZE 32768 /* kilobytes */
+
+static QString cacheKey(const int id, const QString &hash)
+{
+  return QString("%1:%2").arg(id).arg(hash);
+}
+
+ImageCache *ImageCache::cache()
+{
+  static ImageCache *_cache = 0;
+  if (! _cache)
+    _cache = new ImageCache();
+  return _cache;
+}
+
+ImageCache::ImageCache()
+  : _images(CACHESIZE),
+    _hits(0),
+    _misses(0)
+{
+}
+
+/* Only the id and the checksum travel on a hit; image_data is fetched and
+   decoded just when the checksum is new to us.
+ */
+QImage ImageCache::image(const int id)
+{
+  XSqlQuery qry;
+  qry.prepare("SELECT image_id, md5(image_data) AS image_hash"
+              "  FROM image"
+              " WHERE (image_id=:id);");
+  qry.bindValue(":id", id);
+  qry.exec();
+  return lookup(qry);
+}
+
+QImage ImageCache::image(const QString &name)
+{
+  XSqlQuery qry;
+  qry.prepare("SELECT image_id, md5(image_data) AS image_hash"
+              "  FROM image"
+              " WHERE (image_name=:name);");
+  qry.bindValue(":name", name);
+  qry.exec();
+  return lookup(qry);
+}
+
+/* For callers whose own query already selected image_id and
+   md5(image_data) AS image_hash.
+ */
+QImage ImageCache::image(const int id, const QString &hash)
+{
+  QImage *cached = _images.object(cacheKey(id, hash));
+  if (cached)
+  {
+    _hits++;
+    return *cached;
+  }
+
+  _misses++;
+  return fetch(id);
+}
+
+QPixmap ImageCache::pixmap(const int id)
+{
+  return QPixmap::fromImage(image(id));
+}
+
+QPixmap ImageCache::pixmap(const QString &name)
+{
+  return QPixmap::fromImage(image(name));
+}
+
+QImage ImageCache::lookup(XSqlQuery &qry)
+{
+  if (qry.first())
+    return image(qry.value("image_id").toInt(),
+                 qry.value("image_hash").toString());
+  else
+    ErrorReporter::error(QtCriticalMsg, 0,
+                         QObject::tr("Error Getting Image"),
+                         qry, __FILE__, __LINE__);
+  return QImage();
+}
+
+QImage ImageCache::fetch(const int id)
+{
+  XSqlQuery qry;
+  qry.prepare("SELECT image_data, md5(image_data) AS image_hash"
+              "  FROM image"
+              " WHERE (image_id=:id);");
+  qry.bindValue(":id", id);
+  qry.exec();
+  if (qry.first())
+  {
+    QImage *decoded = new QImage();
+    decoded->loadFromData(QUUDecode(qry.value("image_data").toString()));
+    QImage result = *decoded;
+
+    int cost = decoded->byteCount() / 1024 + 1;
+    if (DEBUG)
+      qDebug("ImageCache::fetch(%d) decoded %d kB", id, cost);
+    _images.insert(cacheKey(id, qry.value("image_hash").toString()),
+                   decoded, cost);
+    return result;
+  }
+  else
+    ErrorReporter::error(QtCriticalMsg, 0,
+                         QObject::tr("Error Getting Image"),
+                         qry, __FILE__, __LINE__);
+  return QImage();
+}
+
+int ImageCache::hits() const
+{
+  return _hits;
+}
+
+int ImageCache::misses() const
+{
+  return _misses;
+}
+
+void ImageCache::resetCounters()
+{
+  _hits   = 0;
+  _misses = 0;
+}
+
+int ImageCache::maxCost() const
+{
+  return _images.maxCost();
+}
+
+void ImageCache::setMaxCost(const int kilobytes)
+{
+  _images.setMaxCost(kilobytes);
+}
+
+void ImageCache::clear()
+{
+  _images.clear();
+}
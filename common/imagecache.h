@@ -0,0 +1,58 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __IMAGECACHE_H__
+#define __IMAGECACHE_H__
+
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+#include <QString>
+
+class XSqlQuery;
+
+/*
+    ImageCache holds decoded copies of rows from the image table so icons
+    and pictures don't get fetched, uudecoded and decompressed every time
+    a window shows them. Entries are keyed by image_id and the md5 of
+    image_data, so an edited image is simply a miss and the stale entry
+    ages out of the LRU. The cost of an entry is its size in kilobytes.
+ */
+class ImageCache
+{
+  public:
+    static ImageCache *cache();
+
+    QImage  image(const int id);
+    QImage  image(const QString &name);
+    QImage  image(const int id, const QString &hash);
+    QPixmap pixmap(const int id);
+    QPixmap pixmap(const QString &name);
+
+    int  hits()   const;
+    int  misses() const;
+    void resetCounters();
+
+    int  maxCost() const;
+    void setMaxCost(const int kilobytes);
+    void clear();
+
+  protected:
+    ImageCache();
+
+    QImage fetch(const int id);
+    QImage lookup(XSqlQuery &qry);
+
+    QCache<QString, QImage> _images;
+    int                     _hits;
+    int                     _misses;
+};
+
+#endif
@@ -20,7 +20,11 @@
 #include <QProcess>
 #include <QScriptEngine>
 #include <QScriptValue>
+#include <QRegExp>
+#include <QSqlDatabase>
+#include <QSqlDriver>
 #include <QSqlError>
+#include <QSqlField>
 #include <QTemporaryFile>
 #include <QVariant>
 
@@ -56,6 +60,150 @@ static QString getUniqueFileName(QString poriginalname)
   return newname;
 }
 
+/* importXML() turns each view-level element into a parameterized statement.
+   Consecutive elements that produce the same statement text share one
+   prepared query and are run as a batch under a single savepoint, so the
+   server plans the statement once and the per-row SAVEPOINT and RELEASE
+   round trips go away. If anything in a batch fails, the batch is rolled
+   back and replayed one element at a time with the original per-element
+   savepoint and error handling. A batch of one element, which is what
+   interleaved header and line elements produce, runs as plain SQL text
+   like it always did, since preparing it would only add round trips.
+ */
+#define IMPORTBATCHSIZE 100
+
+struct ImportStatement
+{
+  QString      sql;
+  QVariantList values;
+  QDomElement  elem;
+  QString      savepointName;
+  bool         ignoreErr;
+  bool         silent;
+};
+
+struct ImportState
+{
+  QString       fileName;
+  bool          saveErrorXML;
+  QStringList   errors;
+  QStringList   warnings;
+  QDomDocument  errorDoc;
+  QDomElement   errorRoot;
+};
+
+static void bindImportValues(XSqlQuery &q, const QVariantList &values)
+{
+  for (int i = 0; i < values.size(); i++)
+    q.bindValue(QString(":p%1").arg(i), values.at(i));
+}
+
+/* Put the values back into the statement text as literals quoted by the
+   driver, in one pass so a value that looks like :pN is left alone.
+ */
+static QString inlineImportValues(const ImportStatement &row)
+{
+  QSqlDriver *driver = QSqlDatabase::database().driver();
+  QRegExp     placeholder(":p(\\d+)");
+  QString     sql;
+  int         last = 0;
+  for (int pos = placeholder.indexIn(row.sql); pos >= 0;
+       pos = placeholder.indexIn(row.sql, pos + placeholder.matchedLength()))
+  {
+    QSqlField field(QString(), QVariant::String);
+    field.setValue(row.values.value(placeholder.cap(1).toInt()));
+    sql += row.sql.mid(last, pos - last) + driver->formatValue(field);
+    last = pos + placeholder.matchedLength();
+  }
+  return sql + row.sql.mid(last);
+}
+
+/* Run one element with its own savepoint. \a q is either prepared with
+   the element's statement or, if \a prepared is false, unused until now.
+ */
+static void execImportRow(XSqlQuery &q, const ImportStatement &row,
+                          ImportState &state, bool prepared)
+{
+  XSqlQuery savepoint;
+  bool haveSavepoint = (row.ignoreErr || state.saveErrorXML);
+  if (haveSavepoint)
+    savepoint.exec("SAVEPOINT " + row.savepointName + ";");
+
+  if (prepared)
+  {
+    bindImportValues(q, row.values);
+    q.exec();
+  }
+  else
+    q.exec(inlineImportValues(row));
+  if (q.lastError().type() != QSqlError::NoError)
+  {
+    if (haveSavepoint)
+      savepoint.exec("ROLLBACK TO SAVEPOINT " + row.savepointName + ";");
+    if (row.ignoreErr)
+    {
+      if (! row.silent)
+        state.warnings.append(ImportHelper::tr("Ignored error while importing %1:\n%2")
+                              .arg(row.elem.tagName(), q.lastError().text()));
+    }
+    else if (state.saveErrorXML)
+    {
+      state.warnings.append(ImportHelper::tr("Error processing %1. Saving to retry later:\t%2")
+                            .arg(row.elem.tagName(), q.lastError().text()));
+      QDomNode nodecopy = state.errorDoc.importNode(row.elem, true);
+      nodecopy.appendChild(state.errorDoc.createComment(q.lastError().text()));
+      state.errorRoot.appendChild(nodecopy);
+    }
+    else
+      state.errors.append(ImportHelper::tr("Error importing %1: %2")
+                          .arg(state.fileName, q.lastError().databaseText()));
+  }
+  else if (haveSavepoint)
+    savepoint.exec("RELEASE SAVEPOINT " + row.savepointName + ";");
+}
+
+static void execImportBatch(QList<ImportStatement> &batch, ImportState &state)
+{
+  if (batch.isEmpty())
+    return;
+
+  XSqlQuery q;
+  if (batch.size() == 1)
+  {
+    execImportRow(q, batch.first(), state, false);
+    batch.clear();
+    return;
+  }
+
+  q.prepare(batch.first().sql);
+  XSqlQuery savepoint;
+  savepoint.exec("SAVEPOINT xtimportbatch;");
+  bool ok = (savepoint.lastError().type() == QSqlError::NoError);
+  for (int i = 0; ok && i < batch.size(); i++)
+  {
+    bindImportValues(q, batch.at(i).values);
+    q.exec();
+    ok = (q.lastError().type() == QSqlError::NoError);
+  }
+
+  if (ok)
+  {
+    savepoint.exec("RELEASE SAVEPOINT xtimportbatch;");
+    batch.clear();
+    return;
+  }
+
+  if (DEBUG)
+    qDebug("import batch of %d failed, replaying row by row: %s",
+           batch.size(), qPrintable(q.lastError().text()));
+  savepoint.exec("ROLLBACK TO SAVEPOINT xtimportbatch;");
+  savepoint.exec("RELEASE SAVEPOINT xtimportbatch;");
+
+  for (int i = 0; i < batch.size(); i++)
+    execImportRow(q, batch.at(i), state, true);
+  batch.clear();
+}
+
 CSVImpPluginInterface *ImportHelper::_csvimpplugin = 0;
 
 CSVImpPluginInterface *ImportHelper::getCSVImpPlugin(QObject *parent)
@@ -366,8 +514,6 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
   QString xmldir;
   QString xsltdir;
   QString xsltcmd;
-  QStringList errors;
-  QStringList warnings;
   bool        saveErrorXML = false;
 
   XSqlQuery q;
@@ -475,8 +621,10 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
   // the silent attribute provides the user the option to turn off 
   // the interactive message for the view-level element
 
-  QDomDocument errorDoc;
-  QDomElement errorRoot = errorDoc.appendChild(errorDoc.createElement("xtupleimport")).toElement();
+  ImportState state;
+  state.fileName     = pFileName;
+  state.saveErrorXML = saveErrorXML;
+  state.errorRoot    = state.errorDoc.appendChild(state.errorDoc.createElement("xtupleimport")).toElement();
 
   q.exec("BEGIN;");
   if (q.lastError().type() != QSqlError::NoError)
@@ -489,6 +637,7 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
   rollback.prepare("ROLLBACK;");
 
   QRegExp apos("\\\\*'");
+  QList<ImportStatement> batch;
 
   for (QDomElement viewElem = doc.documentElement().firstChildElement();
        ! viewElem.isNull();
@@ -497,10 +646,13 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
     QStringList columnNameList;
     QStringList columnValueList;
 
-    bool ignoreErr = (viewElem.attribute("ignore", "false").isEmpty() ||
+    ImportStatement stmt;
+    stmt.elem = viewElem;
+
+    stmt.ignoreErr = (viewElem.attribute("ignore", "false").isEmpty() ||
                       viewElem.attribute("ignore", "false") == "true");
 
-    bool silent = (viewElem.attribute("silent", "false").isEmpty() ||
+    stmt.silent = (viewElem.attribute("silent", "false").isEmpty() ||
                    viewElem.attribute("silent", "false") == "true");
 
     QString mode = viewElem.attribute("mode", "insert");
@@ -516,15 +668,8 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
     else // backwards compatibility - must be in the api schema
       viewName = "api." + viewName;
 
-    QString savepointName = viewName;
-    savepointName.remove(".");
-    XSqlQuery rollbacktosavepoint;
-    if (ignoreErr || saveErrorXML)
-    {
-      q.exec("SAVEPOINT " + savepointName + ";");
-      rollbacktosavepoint.prepare("ROLLBACK TO SAVEPOINT " + savepointName + ";");
-    }
-    bool haveSavepoint = (ignoreErr || saveErrorXML);
+    stmt.savepointName = viewName;
+    stmt.savepointName.remove(".");
 
     if (mode.isEmpty())
       mode = "insert";
@@ -536,22 +681,22 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
         keyList.append("order_number");
       else
       {
-        if (haveSavepoint)
-          rollbacktosavepoint.exec();
-        if (ignoreErr || saveErrorXML)
+        execImportBatch(batch, state);
+        if (stmt.ignoreErr || saveErrorXML)
         {
-          warnings.append(tr("Cannot process %1 element without a key attribute"));
+          state.warnings.append(tr("Cannot process %1 element without a key attribute"));
           if (saveErrorXML)
-            errorRoot.appendChild(errorDoc.importNode(viewElem, true));
+            state.errorRoot.appendChild(state.errorDoc.importNode(viewElem, true));
         }
         else
-          errors.append(tr("Cannot process %1 element without a key attribute"));
+          state.errors.append(tr("Cannot process %1 element without a key attribute"));
         continue;       // back to top of viewElem for loop
       }
       if (! viewElem.namedItem("line_number").isNull())
         keyList.append("line_number");
     }
 
+    // literal SQL stays in the statement text, everything else is bound
     for (QDomElement columnElem = viewElem.firstChildElement();
          ! columnElem.isNull();
          columnElem = columnElem.nextSiblingElement())
@@ -565,79 +710,81 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
       columnNameList.append(columnElem.tagName());
 
       if (value.trimmed() == "[NULL]")
-        columnValueList.append("NULL");
+      {
+        columnValueList.append(QString(":p%1").arg(stmt.values.size()));
+        stmt.values.append(QVariant(QVariant::String));
+      }
       else if (value.trimmed().startsWith("SELECT"))
         columnValueList.append("(" + value.trimmed() + ")");
       else if (columnElem.attribute("quote") == "false")
         columnValueList.append(value);
       else
-        columnValueList.append("'" + value.replace(apos, "''") + "'");
+      {
+        // escaped quotes used to be collapsed by the SQL literal
+        if (value.contains('\\'))
+          value.replace(apos, "'");
+        columnValueList.append(QString(":p%1").arg(stmt.values.size()));
+        stmt.values.append(value);
+      }
 
       if (DEBUG)
         qDebug("%s after transformation: /%s/",
                qPrintable(columnElem.tagName()), qPrintable(value));
     }
 
-    QString sql;
     if (mode == "update")
     {
       QStringList whereList;
       for (int i = 0; i < keyList.size(); i++)
-        whereList.append("(" + keyList[i] + "=" +
-                         columnValueList[columnNameList.indexOf(keyList[i])] + ")");
+      {
+        int keyIdx = columnNameList.indexOf(keyList[i]);
+        if (keyIdx < 0)
+          break;
+        QString keyValue = columnValueList[keyIdx];
+        if (keyValue.startsWith(":p"))
+        {
+          stmt.values.append(stmt.values.at(keyValue.mid(2).toInt()));
+          keyValue = QString(":p%1").arg(stmt.values.size() - 1);
+        }
+        whereList.append("(" + keyList[i] + "=" + keyValue + ")");
+      }
+      if (whereList.size() != keyList.size())
+      {
+        execImportBatch(batch, state);
+        if (! stmt.ignoreErr)
+          state.errors.append(tr("Could not process %1: key %2 is not one of its columns")
+                              .arg(viewElem.tagName(), keyList.join(", ")));
+        continue;       // back to top of viewElem for loop
+      }
 
       for (int i = 0; i < columnNameList.size(); i++)
         columnNameList[i].append("=" + columnValueList[i]);
 
-      sql = "UPDATE " + viewName + " SET " +
-            columnNameList.join(", ") +
-            " WHERE (" + whereList.join(" AND ") + ");";
+      stmt.sql = "UPDATE " + viewName + " SET " +
+                 columnNameList.join(", ") +
+                 " WHERE (" + whereList.join(" AND ") + ");";
     }
     else if (mode == "insert")
-      sql = "INSERT INTO " + viewName + " (" +
-            columnNameList.join(", ") +
-            " ) SELECT " +
-            columnValueList.join(", ") + ";" ;
+      stmt.sql = "INSERT INTO " + viewName + " (" +
+                 columnNameList.join(", ") +
+                 " ) VALUES (" +
+                 columnValueList.join(", ") + ");" ;
     else
     {
-      if (haveSavepoint)
-        rollbacktosavepoint.exec();
-      if (! ignoreErr)
-        errors.append(tr("Could not process %1: invalid mode %2")
-                      .arg(viewElem.tagName(), mode));
+      execImportBatch(batch, state);
+      if (! stmt.ignoreErr)
+        state.errors.append(tr("Could not process %1: invalid mode %2")
+                            .arg(viewElem.tagName(), mode));
       continue;       // back to top of viewElem for loop
     }
 
-    if (DEBUG) qDebug("About to run this: %s", qPrintable(sql));
-    q.exec(sql);
-    if (q.lastError().type() != QSqlError::NoError)
-    {
-      if (haveSavepoint)
-        rollbacktosavepoint.exec();
-      if (ignoreErr)
-      {
-        if (! silent)
-          warnings.append(tr("Ignored error while importing %1:\n%2")
-                              .arg(viewElem.tagName(), q.lastError().text()));
-      }
-      else if (saveErrorXML)
-      {
-        warnings.append(tr("Error processing %1. Saving to retry later:\t%2")
-                              .arg(viewElem.tagName(), q.lastError().text()));
-        QDomNode nodecopy = errorDoc.importNode(viewElem, true);
-        nodecopy.appendChild(errorDoc.createComment(q.lastError().text()));
-        errorRoot.appendChild(nodecopy);
-      }
-      else
-      {
-        errors.append(tr("Error importing %1: %2")
-                      .arg(pFileName, q.lastError().databaseText()));
-        continue;       // back to top of viewElem for loop
-      }
-    }
-    else if (haveSavepoint)
-      q.exec("RELEASE SAVEPOINT " + savepointName + ";");
+    if (DEBUG) qDebug("About to run this: %s", qPrintable(stmt.sql));
+    if (! batch.isEmpty() &&
+        (batch.first().sql != stmt.sql || batch.size() >= IMPORTBATCHSIZE))
+      execImportBatch(batch, state);
+    batch.append(stmt);
   }
+  execImportBatch(batch, state);
 
   q.exec("COMMIT;");
   if (q.lastError().type() != QSqlError::NoError)
@@ -650,23 +797,23 @@ bool ImportHelper::importXML(const QString &pFileName, QString &errmsg, QString
   if (! tmpfileName.isEmpty())
     QFile::remove(tmpfileName);
 
-  if (warnings.size() > 0)
-    warnmsg = warnings.join("\n");
+  if (state.warnings.size() > 0)
+    warnmsg = state.warnings.join("\n");
 
   QString fileerrmsg;
   if (! handleFilePostImport(pFileName,
-                             errors.size() == 0,
+                             state.errors.size() == 0,
                              fileerrmsg,
-                             errorRoot.hasChildNodes() ? errorDoc.toString()
-                                                       : QString()))
+                             state.errorRoot.hasChildNodes() ? state.errorDoc.toString()
+                                                             : QString()))
   {
-    errors.append(fileerrmsg);
+    state.errors.append(fileerrmsg);
     return false;
   }
 
-  errmsg = errors.join(tr("\n"));
+  errmsg = state.errors.join(tr("\n"));
 
-  return errors.size() == 0;
+  return state.errors.size() == 0;
 }
 
 bool ImportHelper::openDomDocument(const QString &pFileName, QDomDocument &pDoc, QString &errmsg)
@@ -0,0 +1,78 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "metasqlcache.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+
+#include <metasql.h>
+#include <mqlutil.h>
+
+#define DEBUG false
+
+MetaSQLCache *MetaSQLCache::cache()
+{
+  static MetaSQLCache *_cache = 0;
+  if (! _cache)
+    _cache = new MetaSQLCache(QCoreApplication::instance());
+  _cache->checkConnection();
+  return _cache;
+}
+
+MetaSQLCache::MetaSQLCache(QObject *parent)
+  : NotifyCache(QStringList() << "metasql", parent)
+{
+}
+
+MetaSQLCache::~MetaSQLCache()
+{
+  clear();
+}
+
+/*! \brief Return the parsed query for the given metasql group and name.
+
+  The first request for a statement loads it with MQLUtil::mqlLoad;
+  later requests get the same parsed query back. Statements that fail
+  to load are not cached, so the next request tries again.
+
+  \return 0 and sets \a ok to false if the statement could not be loaded
+ */
+MetaSQLQuery *MetaSQLCache::query(const QString &group, const QString &name,
+                                  QString &errorString, bool *ok)
+{
+  QString key = group + "/" + name;
+  if (_queries.contains(key))
+  {
+    if (ok)
+      *ok = true;
+    return _queries.value(key);
+  }
+
+  bool loaded = true;
+  MetaSQLQuery mql = MQLUtil::mqlLoad(group, name, errorString, &loaded);
+  if (ok)
+    *ok = loaded;
+  if (! loaded)
+    return 0;
+
+  if (DEBUG)
+    qDebug() << "MetaSQLCache::query() caching" << key;
+
+  MetaSQLQuery *parsed = new MetaSQLQuery(mql.getSource());
+  _queries.insert(key, parsed);
+  return parsed;
+}
+
+void MetaSQLCache::clear()
+{
+  qDeleteAll(_queries);
+  _queries.clear();
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __METASQLCACHE_H__
+#define __METASQLCACHE_H__
+
+#include <QHash>
+#include <QString>
+
+#include "notifycache.h"
+
+class MetaSQLQuery;
+
+/*
+    MetaSQLCache keeps one parsed MetaSQLQuery per group and name so
+    windows that refresh often don't fetch and parse the same metasql
+    statement every time. The cache is emptied whenever the metasql
+    table sends a NOTIFY or the connection is lost. The cache owns the
+    queries it hands out; don't hold on to one past the call that asked
+    for it.
+ */
+class MetaSQLCache : public NotifyCache
+{
+  Q_OBJECT
+
+  public:
+    static MetaSQLCache *cache();
+    virtual ~MetaSQLCache();
+
+    MetaSQLQuery *query(const QString &group, const QString &name,
+                        QString &errorString, bool *ok = 0);
+
+  public slots:
+    virtual void clear();
+
+  protected:
+    MetaSQLCache(QObject *parent = 0);
+
+    QHash<QString, MetaSQLQuery*> _queries;
+};
+
+#endif
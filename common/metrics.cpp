@@ -179,6 +179,9 @@ void Preferences::remove(const QString &pPrefName)
 Privileges::Privileges()
 {
   _notifyName = "usrprivUpdated";
+  _dbaKnown   = false;
+  _dba        = false;
+
   QString user;
   XSqlQuery userq("SELECT getEffectiveXtUser() AS user;");
   if (userq.lastError().type() != QSqlError::NoError)
@@ -200,10 +203,29 @@ Privileges::Privileges()
   QSqlDatabase::database().driver()->subscribeToNotification("usrprivUpdated");
   QObject::connect(QSqlDatabase::database().driver(), SIGNAL(notification(const QString&)),
            this, SLOT(sSetDirty(const QString &)));
+  connect(this, SIGNAL(loaded()), this, SLOT(sClearCache()));
 
   load();
 }
 
+/* Split a privilege expression the first time it's seen. The pieces are
+   checked recursively, so each of them gets split (once) as well.
+ */
+const Privileges::Expression &Privileges::expression(const QString &pName)
+{
+  QHash<QString, Expression>::const_iterator it = _expressions.constFind(pName);
+  if (it != _expressions.constEnd())
+    return it.value();
+
+  Expression expr;
+  if (pName.contains(" "))
+    expr.anyOf = pName.split(' ', QString::SkipEmptyParts);
+  if (pName.contains("+"))
+    expr.allOf = pName.split('+', QString::SkipEmptyParts);
+
+  return _expressions.insert(pName, expr).value();
+}
+
 bool Privileges::check(const QString &pName)
 {
     if (pName == "#superuser")
@@ -212,39 +234,61 @@ bool Privileges::check(const QString &pName)
     if(_dirty)
       load();
 
-    MetricMap::iterator it = _values.find(pName);
-    if (it != _values.end())
-      return true;
+    QHash<QString, bool>::const_iterator cached = _results.constFind(pName);
+    if (cached != _results.constEnd())
+      return cached.value();
+
+    bool result = _values.contains(pName);
 
-    if (pName.contains(" ")) {
-      QStringList privlist = pName.split(' ', QString::SkipEmptyParts);
-      foreach (QString priv, privlist) {
-        if (check(priv))
-          return true;
+    if (! result) {
+      Expression expr = expression(pName);
+      foreach (QString priv, expr.anyOf) {
+        if (check(priv)) {
+          result = true;
+          break;
+        }
       }
-    }
 
-    if (pName.contains("+")) {
-      bool anded = true;
-      QStringList privlist = pName.split('+', QString::SkipEmptyParts);
-      foreach (QString priv, privlist) {
-        anded = anded && check(priv);
+      if (! result && ! expr.allOf.isEmpty()) {
+        result = true;
+        foreach (QString priv, expr.allOf) {
+          result = result && check(priv);
+        }
       }
-      return anded;
     }
 
- return false;
+    _results.insert(pName, result);
+    return result;
 }
 
+/* isDBA() only changes with the user's privileges, so ask once and
+   again after each usrprivUpdated notification.
+ */
 bool Privileges::isDba()
 {
+  if (_dirty)
+    load();
+
+  if (_dbaKnown)
+    return _dba;
+
   XSqlQuery su("SELECT isDBA() AS issuper;");
   su.exec();
   if (su.first())
-    return su.value("issuper").toBool();
+  {
+    _dba      = su.value("issuper").toBool();
+    _dbaKnown = true;
+    return _dba;
+  }
   else if (su.lastError().type() != QSqlError::NoError)
     qWarning("SQL error in Privileges::isDba(): %s",
              qPrintable(su.lastError().text()));
 
   return false;
 }
+
+void Privileges::sClearCache()
+{
+  _results.clear();
+  _dbaKnown = false;
+}
@@ -12,8 +12,10 @@
 #ifndef metrics_h
 #define metrics_h
 
+#include <QHash>
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QMap>
 
 typedef QMap<QString, QString> MetricMap;
@@ -90,6 +92,25 @@ class Privileges : public Parameters
   public slots:
     bool check(const QString &);
     bool isDba();
+
+  protected slots:
+    void sClearCache();
+
+  protected:
+    /* a privilege expression split once into its space-separated
+       alternatives and plus-separated requirements */
+    struct Expression
+    {
+      QStringList anyOf;
+      QStringList allOf;
+    };
+
+    const Expression &expression(const QString &);
+
+    QHash<QString, Expression> _expressions;
+    QHash<QString, bool>       _results;
+    bool                       _dbaKnown;
+    bool                       _dba;
 };
 
 #endif
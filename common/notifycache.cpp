@@ -0,0 +1,96 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "notifycache.h"
+
+#include <QDebug>
+#include <QSqlDatabase>
+#include <QSqlDriver>
+
+#define DEBUG false
+
+QList<NotifyCache*> NotifyCache::_caches;
+
+NotifyCache::NotifyCache(const QStringList &notifications, QObject *parent)
+  : QObject(parent),
+    _tablesToWatch(notifications),
+    _listening(false)
+{
+  _caches.append(this);
+  checkConnection();
+}
+
+NotifyCache::~NotifyCache()
+{
+  _caches.removeAll(this);
+}
+
+/*! \brief Clear every cache because the database connection went away.
+
+  Call this when the connection is found to be dead. Any notifications
+  sent before it is reopened are lost, so nothing cached can be trusted.
+ */
+void NotifyCache::connectionLost()
+{
+  foreach (NotifyCache *cache, _caches)
+    cache->clear();
+}
+
+/*! \brief Make sure the cache is listening on the current connection.
+
+  Closing a connection drops its LISTENs, and a replaced connection has
+  a new driver. In either case the cache may have missed notifications,
+  so it is cleared before subscribing again.
+ */
+void NotifyCache::checkConnection()
+{
+  QSqlDatabase db = QSqlDatabase::database(QSqlDatabase::defaultConnection, false);
+  if (! db.isValid() || ! db.isOpen() || ! db.driver())
+    return;
+
+  QSqlDriver  *driver     = db.driver();
+  QStringList  subscribed = driver->subscribedToNotifications();
+  bool current = _listening && driver == _driver;
+  foreach (QString tableName, _tablesToWatch)
+  {
+    if (! subscribed.contains(tableName))
+      current = false;
+  }
+  if (current)
+    return;
+
+  if (DEBUG)
+    qDebug() << "NotifyCache::checkConnection() subscribing to" << _tablesToWatch
+             << (_listening ? "after losing the connection" : "");
+
+  if (_listening)
+    clear();
+
+  if (_driver && _driver != driver)
+    disconnect(_driver, SIGNAL(notification(const QString&)),
+               this,    SLOT(sNotified(const QString &)));
+
+  foreach (QString tableName, _tablesToWatch)
+  {
+    if (! subscribed.contains(tableName))
+      driver->subscribeToNotification(tableName);
+  }
+  connect(driver, SIGNAL(notification(const QString&)),
+          this,   SLOT(sNotified(const QString &)), Qt::UniqueConnection);
+
+  _driver    = driver;
+  _listening = true;
+}
+
+void NotifyCache::sNotified(const QString &pNotification)
+{
+  if (_tablesToWatch.contains(pNotification))
+    clear();
+}
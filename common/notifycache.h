@@ -0,0 +1,56 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __NOTIFYCACHE_H__
+#define __NOTIFYCACHE_H__
+
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+
+class QSqlDriver;
+
+/*
+    NotifyCache is the base for process-wide caches of database data.
+    It LISTENs for the given notifications and calls clear() when one
+    arrives. Notifications sent while the connection was closed, lost
+    or replaced never reach us, so the cache is also cleared then:
+    subclasses call checkConnection() before each lookup, and the
+    application calls connectionLost() when it notices a dead connection.
+ */
+class NotifyCache : public QObject
+{
+  Q_OBJECT
+
+  public:
+    virtual ~NotifyCache();
+
+    static void connectionLost();
+
+  public slots:
+    virtual void clear() = 0;
+    virtual void sNotified(const QString &pNotification);
+
+  protected:
+    NotifyCache(const QStringList &notifications, QObject *parent = 0);
+
+    void checkConnection();
+
+    QStringList _tablesToWatch;
+
+  private:
+    QPointer<QSqlDriver> _driver;
+    bool                 _listening;
+
+    static QList<NotifyCache*> _caches;
+};
+
+#endif
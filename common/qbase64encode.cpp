@@ -12,123 +12,227 @@
 
 #include <QString>
 #include <QIODevice>
-#include <QTextStream>
 #include <QBuffer>
 
+// 19 packets of 3 bytes make one 76 character line of output
+#define LINEBYTES    57
+#define ENCODEBLOCK  (LINEBYTES * 1024)
+#define DECODEBLOCK  (64 * 1024)
+
 static const char _base64Table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-static char getValue(char c) {
-    int i = 0;
-    while(_base64Table[i] != '\0') {
-        if(_base64Table[i] == c) return (char)i;
-        i++;
+/* reverse lookup: the 6-bit value of each alphabet character,
+   PAD for '=' and SKIP for everything else */
+#define PAD  64
+#define SKIP 65
+
+class Base64Values
+{
+  public:
+    Base64Values()
+    {
+      for (int i = 0; i < 256; i++)
+        value[i] = SKIP;
+      for (int i = 0; i < 64; i++)
+        value[(unsigned char)_base64Table[i]] = i;
+      value[(unsigned char)'='] = PAD;
+    }
+
+    unsigned char value[256];
+};
+
+static const Base64Values _base64Values;
+
+/* Encode len bytes that start on a line boundary. A newline follows
+   every 19th packet, including a short final packet, as it always has.
+   Returns the number of characters written to out.
+ */
+static int encodeBlock(const unsigned char *in, int len, char *out)
+{
+  char *o = out;
+  int packet = 0;
+  int i = 0;
+
+  for (; i + 3 <= len; i += 3)
+  {
+    unsigned int triple = (in[i] << 16) | (in[i + 1] << 8) | in[i + 2];
+    o[0] = _base64Table[(triple >> 18) & 0x3F];
+    o[1] = _base64Table[(triple >> 12) & 0x3F];
+    o[2] = _base64Table[(triple >>  6) & 0x3F];
+    o[3] = _base64Table[ triple        & 0x3F];
+    o += 4;
+    if (++packet >= 19)
+    {
+      packet = 0;
+      *o++ = '\n';
     }
-    return (char)-1;
+  }
+
+  if (i < len)
+  {
+    unsigned int triple = in[i] << 16;
+    if (i + 1 < len)
+      triple |= in[i + 1] << 8;
+    o[0] = _base64Table[(triple >> 18) & 0x3F];
+    o[1] = _base64Table[(triple >> 12) & 0x3F];
+    o[2] = (i + 1 < len) ? _base64Table[(triple >> 6) & 0x3F] : '=';
+    o[3] = '=';
+    o += 4;
+    if (++packet >= 19)
+      *o++ = '\n';
+  }
+
+  return o - out;
 }
 
-QString QBase64Encode(QIODevice & iod) {
-    QString value;  // the string that holds the final encoded values
-    int packet = 0; // there are 19 packets per line (packet=3 bytes in)
+/* Decoding state carried from one block of input to the next. */
+struct Base64Decoder
+{
+  Base64Decoder() : bits(0), count(0), done(false) {}
+
+  unsigned int bits;
+  int          count;
+  bool         done;
+
+  /* Decode len characters into out, which must have room for 3/4 of
+     len plus 3. Characters outside the alphabet are skipped; the first
+     '=' ends the data. Returns the number of bytes written.
+   */
+  int decode(const char *in, int len, char *out)
+  {
+    char *o = out;
+    for (int i = 0; i < len && ! done; i++)
+    {
+      unsigned char v = _base64Values.value[(unsigned char)in[i]];
+      if (v == SKIP)
+        continue;
+      if (v == PAD)
+      {
+        o += finish(o);
+        break;
+      }
+
+      bits = (bits << 6) | v;
+      if (++count == 4)
+      {
+        o[0] = (char)(bits >> 16);
+        o[1] = (char)(bits >> 8);
+        o[2] = (char)bits;
+        o += 3;
+        bits  = 0;
+        count = 0;
+      }
+    }
+    return o - out;
+  }
+
+  /* Flush a short final group, whether or not it was padded. */
+  int finish(char *out)
+  {
+    int written = 0;
+    if (! done)
+    {
+      if (count == 2)
+      {
+        out[0] = (char)(bits >> 4);
+        written = 1;
+      }
+      else if (count == 3)
+      {
+        out[0] = (char)(bits >> 10);
+        out[1] = (char)(bits >> 2);
+        written = 2;
+      }
+      done = true;
+    }
+    return written;
+  }
+};
 
-    char _in[3];
-    unsigned char in[3];
-    char out[4];
+/*! Encode the rest of \a in to \a out as base64, 76 characters per line.
+    \return false if writing to \a out failed
+ */
+bool QBase64Encode(QIODevice & in, QIODevice & out)
+{
+  QByteArray inbuf(ENCODEBLOCK, '\0');
+  QByteArray outbuf(ENCODEBLOCK / 3 * 4 + ENCODEBLOCK / LINEBYTES + 8, '\0');
+
+  while (! in.atEnd())
+  {
+    // fill whole blocks so every block but the last starts a new line
     qint64 didRead = 0;
-
-    while(!iod.atEnd()) {
-        // set the values to 0 in case we don't read all 3
-        _in[0] = _in[1] = _in[2] = (char)0;
-
-        // read in up to the next 3 chars
-        didRead = iod.read(&_in[0], 3);
-
-        in[0] = (unsigned char)_in[0];
-        in[1] = (unsigned char)_in[1];
-        in[2] = (unsigned char)_in[2];
-
-        if(didRead > 0) {
-            // determine the encoded chars
-            out[0] = _base64Table[ in[0] >> 2 ];
-            out[1] = _base64Table[ ((in[0] & 0x03) << 4) | (in[1] >> 4) ];
-            out[2] = _base64Table[ ((in[1] & 0x0F) << 2) | (in[2] >> 6) ];
-            out[3] = _base64Table[ in[2] & 0x3F ];
-
-            // modify the chars if we were short
-            if(didRead < 3) {
-                out[3] = '=';
-                if(didRead < 2) {
-                    out[2] = '=';
-                }
-            }
-
-            // place the final chars in the value
-            value += out[0];
-            value += out[1];
-            value += out[2];
-            value += out[3];
-        }
-
-
-        if(++packet >= 19) {
-            packet = 0;    // reset the packet count
-            value += '\n'; // add a newline to the value
-        }
+    while (didRead < ENCODEBLOCK && ! in.atEnd())
+    {
+      qint64 n = in.read(inbuf.data() + didRead, ENCODEBLOCK - didRead);
+      if (n <= 0)
+        break;
+      didRead += n;
     }
-    value += '\n'; // throw one last newline onto the end
+    if (didRead <= 0)
+      break;
 
-    return value;
+    int chars = encodeBlock((const unsigned char *)inbuf.constData(), (int)didRead,
+                            outbuf.data());
+    if (out.write(outbuf.constData(), chars) != chars)
+      return false;
+  }
+
+  return out.write("\n", 1) == 1; // throw one last newline onto the end
 }
 
-QByteArray QBase64Decode(const QString & _source) {
-    QString source = _source;
+QString QBase64Encode(QIODevice & iod) {
+    QByteArray value;
+    if (! iod.isSequential() && iod.size() > iod.pos())
+        value.reserve((int)((iod.size() - iod.pos()) / 3 * 4 +
+                            (iod.size() - iod.pos()) / LINEBYTES + 8));
+
+    QBuffer buf(&value);
+    buf.open(QIODevice::WriteOnly);
+    QBase64Encode(iod, buf);
+    buf.close();
+
+    return QString::fromLatin1(value.constData(), value.size());
+}
+
+/*! Decode the base64 text in the rest of \a in and write the bytes to
+    \a out. Whitespace and other characters outside the base64 alphabet
+    are ignored and decoding stops at the first '='.
+    \return false if writing to \a out failed
+ */
+bool QBase64Decode(QIODevice & in, QIODevice & out)
+{
+  Base64Decoder decoder;
+  QByteArray inbuf(DECODEBLOCK, '\0');
+  QByteArray outbuf(DECODEBLOCK / 4 * 3 + 3, '\0');
+
+  while (! in.atEnd() && ! decoder.done)
+  {
+    qint64 didRead = in.read(inbuf.data(), inbuf.size());
+    if (didRead <= 0)
+      break;
+
+    int bytes = decoder.decode(inbuf.constData(), (int)didRead, outbuf.data());
+    if (out.write(outbuf.constData(), bytes) != bytes)
+      return false;
+  }
+
+  int bytes = decoder.finish(outbuf.data());
+  return out.write(outbuf.constData(), bytes) == bytes;
+}
+
+QByteArray QBase64Decode(const QString & source) {
     QByteArray value;
 
     // empty string -- nothing to do
     if(source.isEmpty()) return value;
 
-    QTextStream in(&source, QIODevice::ReadOnly);
+    QByteArray text = source.toLatin1();
+    value.resize(text.size() / 4 * 3 + 3);
 
-    QBuffer buf(&value);
-    buf.open(QIODevice::WriteOnly);
-
-    char a[4], b[4], o[3];
-    qint64 n = 0;
-    int p = 0; // current position in string
-    int l = source.length(); // length of string
-    char c = 0;
-    while (p < l) {
-        // read in the next 4 valid bytes
-        n = 0;
-        while(n < 4 && p < l) {
-            c = ((QChar)source.at(p++)).toLatin1();
-            a[n] = c;
-            b[n] = (c == '=' ? 0 : getValue(c));
-            if(b[n] != -1) {
-                n++;
-            }
-        }
-
-        if(n < 4 && n != 0) {
-            // whoops we have a mismatch in the number of bytes we need
-        }
-
-        // convert from base64 to binary
-        o[0] = (b[0] << 2) | (b[1] >> 4);
-        o[1] = (b[1] << 4) | (b[2] >> 2);
-        o[2] = (b[2] << 6) | b[3];
-
-        // determine how many bytes we should be reading
-        if(a[2] == '=')      n = 1;
-        else if(a[3] == '=') n = 2;
-        else                 n = 3;
-
-        if(n != buf.write(&o[0], n)) {
-            // eek we didn't write the number of block we were supposed to
-        }
-
-        if(n < 3) break; // we've reached the end of the data we have to read so just stop
-    }
+    Base64Decoder decoder;
+    int n = decoder.decode(text.constData(), text.size(), value.data());
+    n += decoder.finish(value.data() + n);
+    value.truncate(n);
 
     return value;
 }
-
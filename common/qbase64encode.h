@@ -16,7 +16,9 @@
 class QIODevice;
 
 QString    QBase64Encode(QIODevice &);
+bool       QBase64Encode(QIODevice &in, QIODevice &out);
 QByteArray QBase64Decode(const QString &);
+bool       QBase64Decode(QIODevice &in, QIODevice &out);
 
 #endif
 
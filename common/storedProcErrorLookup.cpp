@@ -9,33 +9,39 @@
  */
 
 #include <QMessageBox>
-#include <QMultiHash>
+#include <QHash>
+#include <QList>
 #include <QObject>
 #include <QPair>
+#include <QSet>
 #include <QString>
 #include <QCoreApplication>
 
+#include <algorithm>
+
 /*	try to address bug 4218
   This code assumes that stored procedures
   return zero or positive integers on success
   return negative integers on failure
  */
 
-QMultiHash< QString, QPair<int, QString> >	ErrorLookupHash;
+typedef QPair<QString, int> ErrorKey;
 
 /*
   developers add error messages to an array for ease of adding new ones.
-  initErrorLookupHash then inserts these into a QMultiHash(key, value).
-  The key is the stored procedure name.
-  The value is a QPair* of (return value, error message).
+  initErrorLookupHash then inserts these into a QHash(key, value) the
+  first time an error is looked up.
+  The key is the upper-cased stored procedure name and the return value.
+  The value is the translated error message, with proxies already resolved.
+  The array holds only plain C strings so nothing is constructed at startup.
 */
 
-const struct {
-  QString	procName;	// name of the stored procedure
+static const struct {
+  const char*	procName;	// name of the stored procedure
   int		retVal;		// return value from the stored procedure
   const char*	msg;		// msg to display, but see msgPtr and proxyName
   int		msgPtr;		// if <> 0 then look up (procName, msgPtr)
-  QString	proxyName;	// look up (proxyName, retVal)
+  const char*	proxyName;	// look up (proxyName, retVal)
 } errors[] = {
 
   { "attachQuoteToOpportunity", -1, QT_TRANSLATE_NOOP("storedProcErrorLookup", "The selected Quote cannot be attached because "
@@ -1685,47 +1691,35 @@ const struct {
   { "woClockIn", -12, QT_TRANSLATE_NOOP("storedProcErrorLookup", "Work Order %1 is closed."),			0, "" },
 };
 
-void initErrorLookupHash()
+static void initErrorLookupHash(QHash<ErrorKey, QString> &lookup)
 {
-  if (! ErrorLookupHash.isEmpty())
-  {
-    QMessageBox::critical(0, QCoreApplication::translate("storedProcErrorLookup", "ErrorLookupHash initialization error"),
-		QCoreApplication::translate("storedProcErrorLookup", "ErrorLookupHash has already been initialized."));
-    return;
-  }
-
   unsigned int numElems = sizeof(errors) / sizeof(errors[0]);
+
+  // where each (procedure, return value) appears, in table order,
+  // so forward proxies can find the next occurrence after themselves
+  QHash<ErrorKey, QList<unsigned int> > indices;
+  for (unsigned int i = 0; i < numElems; i++)
+    indices[ErrorKey(QString(errors[i].procName).toUpper(), errors[i].retVal)].append(i);
+
+  QSet<QString> procsInserted;
   for (unsigned int i = 0; i < numElems; i++)
   {
-    QPair<int, QString> currPair;
+    QString procname = QString(errors[i].procName).toUpper();
+    QString message;
     if (errors[i].msgPtr == 0)
-      currPair = qMakePair(errors[i].retVal, QCoreApplication::translate("storedProcErrorLookup", errors[i].msg));
+      message = QCoreApplication::translate("storedProcErrorLookup", errors[i].msg);
     else
     {
-      QList<QPair<int, QString> > proxyList;
-
       QString proxyname;
-      if (errors[i].proxyName.isEmpty())
-	proxyname = errors[i].procName.toUpper();
+      if (qstrlen(errors[i].proxyName) == 0)
+	proxyname = procname;
       else
-	proxyname = errors[i].proxyName.toUpper();
-
-      proxyList = ErrorLookupHash.values(proxyname);
+	proxyname = QString(errors[i].proxyName).toUpper();
 
-      if (proxyList.size() > 0)
+      ErrorKey proxykey(proxyname, errors[i].msgPtr);
+      if (procsInserted.contains(proxyname))
       {
-	int proxyIndex;
-	for (proxyIndex = 0; proxyIndex < proxyList.size(); proxyIndex++)
-	{
-	  if (proxyList.at(proxyIndex).first == errors[i].msgPtr)
-	  {
-	    currPair = qMakePair(errors[i].retVal,
-				 QString(proxyList.at(proxyIndex).second));
-	    break;
-	  }
-	}
-
-	if (proxyIndex >= proxyList.size())
+        if (! lookup.contains(proxykey))
 	{
           QMessageBox::critical(0, QCoreApplication::translate("storedProcErrorLookup", "Lookup Error"),
                                 QCoreApplication::translate("storedProcErrorLookup",
@@ -1736,21 +1730,14 @@ void initErrorLookupHash()
 			   .arg(errors[i].procName).arg(errors[i].retVal));
 	  continue;
 	}
+	message = lookup.value(proxykey);
       }
-      else // couldn't find proxyList => forward reference
+      else // proxy hasn't been inserted yet => forward reference
       {
-	unsigned int j;
-	for (j = i + 1; j < numElems; j++)
-	{
-	  if (errors[j].retVal == errors[i].msgPtr &&
-	      errors[j].procName.toUpper() == proxyname)
-	    {
-	    currPair = qMakePair(errors[i].retVal,
-				 QString(QCoreApplication::translate("storedProcErrorLookup", errors[j].msg)));
-	    break;
-	    }
-	}
-	if (j >= numElems)
+	const QList<unsigned int> candidates = indices.value(proxykey);
+	QList<unsigned int>::const_iterator next =
+	  std::upper_bound(candidates.constBegin(), candidates.constEnd(), i);
+	if (next == candidates.constEnd())
 	{
           QMessageBox::critical(0, QCoreApplication::translate("storedProcErrorLookup", "Lookup Error"),
                                 QCoreApplication::translate("storedProcErrorLookup",
@@ -1759,33 +1746,25 @@ void initErrorLookupHash()
                                    "(%3, %4).")
 			  .arg(errors[i].proxyName).arg(errors[i].msgPtr)
 			  .arg(errors[i].procName).arg(errors[i].retVal));
-	continue;
+	  continue;
 	}
+	message = QCoreApplication::translate("storedProcErrorLookup", errors[*next].msg);
       }
     }
 
-    ErrorLookupHash.insert(errors[i].procName.toUpper(), currPair);
+    lookup.insert(ErrorKey(procname, errors[i].retVal), message);
+    procsInserted.insert(procname);
   } // for
 }
 
 
 QString storedProcErrorLookup(const QString procName, const int retVal)
 {
-  QString returnStr = "";
-
-  if (ErrorLookupHash.isEmpty())
-    initErrorLookupHash();
+  static QHash<ErrorKey, QString> lookup;
+  if (lookup.isEmpty())
+    initErrorLookupHash(lookup);
 
-  QList<QPair<int, QString> > list = ErrorLookupHash.values(procName.toUpper());
-
-  for (int i = 0; i < list.size(); i++)
-  {
-    if (list.at(i).first == retVal)
-    {
-      returnStr = list.at(i).second;
-      break;
-    }
-  }
+  QString returnStr = lookup.value(ErrorKey(procName.toUpper(), retVal));
 
   if (returnStr.isEmpty())
     returnStr = QCoreApplication::translate("storedProcErrorLookup", "A Stored Procedure failed to run properly.");
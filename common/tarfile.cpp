@@ -10,8 +10,19 @@
 
 #include "tarfile.h"
 
+#include <zlib.h>
+
 #include <qtextstream.h>
 #include <qbuffer.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qstringlist.h>
+#if QT_VERSION >= 0x050000
+#include <QTemporaryDir>
+#endif
+
+#define EXTRACTBUFSIZE (256 * 1024)
 
 struct tarHeaderBlock {
     char name[100];     // name of file
@@ -43,6 +54,47 @@ const char TYPE_FIFO        = '6';  // FIFO special file
 const char TYPE_CONTIGUOS   = '7';  // RESERVERED/Contiguous file
 
 
+/* Check the magic and pull the name and size out of a header block.
+   Old-style regular files are marked as regular files on the way.
+ */
+static bool parseHeader(tarHeaderBlock &head, QString &name, long &size)
+{
+  QString magic(QByteArray(head.magic, qstrnlen(head.magic, sizeof head.magic)));
+  if(magic.trimmed() != "ustar")
+    return false;
+
+  name = QString(QByteArray(head.name, qstrnlen(head.name, sizeof head.name)));
+  QString str(QByteArray(head.size, qstrnlen(head.size, sizeof head.size)));
+  bool valid = false;
+  size = str.trimmed().toLong(&valid, 8);
+  if(!valid)
+    size = 0;
+
+  if(head.typeflag == TYPE_REGULAR_ALT)
+    head.typeflag = TYPE_REGULAR;
+
+  return true;
+}
+
+/* gzread() may return less than asked for, so keep reading until len
+   bytes arrive or the stream ends. Returns the number of bytes read or
+   -1 on a decompression error.
+ */
+static int gzreadFully(gzFile fin, char *buf, int len)
+{
+  int total = 0;
+  while(total < len)
+  {
+    int count = gzread(fin, buf + total, len - total);
+    if(count < 0)
+      return -1;
+    if(count == 0)
+      break;
+    total += count;
+  }
+  return total;
+}
+
 TarFile::TarFile(const QByteArray & bytes)
 {
   Q_UNUSED(TYPE_LINK);
@@ -59,11 +111,10 @@ TarFile::TarFile(const QByteArray & bytes)
   if(!fin.open(QIODevice::ReadOnly))
     return;
 
-  bool valid = false;
   long size = 0;
   long blocks = 0;
   char block[512];
-  QString name, str;
+  QString name;
 
   while(!fin.atEnd())
   {
@@ -73,18 +124,9 @@ TarFile::TarFile(const QByteArray & bytes)
     if(head.name[0] == '\0' && head.size[0] == '\0' && head.typeflag == '\0')
       continue;
 
-    QString magic(head.magic);
-    if(magic.trimmed() != "ustar")
+    if(!parseHeader(head, name, size))
       return;
 
-    name = QString(head.name);
-    str = QString(head.size);
-    str.remove(sizeof head.size, sizeof head);
-    size = str.toLong(&valid, 8);
-
-    if(head.typeflag == TYPE_REGULAR_ALT)
-      head.typeflag = TYPE_REGULAR;
-
     blocks = (size + 511) / 512;
 
     if(head.typeflag == TYPE_REGULAR)
@@ -113,3 +155,135 @@ TarFile::TarFile(const QByteArray & bytes)
 TarFile::~TarFile()
 {
 }
+
+/*! \brief Uncompress the tar.gz file \a gzfile and write its regular
+           files into the directory \a dir.
+
+  Unlike gunzipFile() followed by the TarFile constructor, this reads the
+  archive a buffer at a time and writes each entry as it's decoded, so
+  memory use doesn't grow with the size of the archive. Entries whose
+  names would land outside \a dir are skipped and reported as write
+  errors.
+
+  The files are written to a temporary directory next to \a dir and
+  only moved into \a dir once the whole archive has been read, so a
+  truncated or corrupt download doesn't overwrite the files already
+  there.
+ */
+TarFile::ExtractResult TarFile::extract(const QString &gzfile, const QString &dir)
+{
+  gzFile fin = gzopen(QFile::encodeName(gzfile).constData(), "rb");
+  if(!fin)
+    return UncompressError;
+  gzbuffer(fin, EXTRACTBUFSIZE);
+
+  QDir destdir(dir);
+  QString root = QDir::cleanPath(destdir.absolutePath()) + "/";
+#if QT_VERSION >= 0x050000
+  QTemporaryDir tmpdir(QDir::cleanPath(destdir.absolutePath()) + ".extract-XXXXXX");
+  if(!tmpdir.isValid())
+  {
+    gzclose(fin);
+    return WriteError;
+  }
+  QDir stagedir(tmpdir.path());
+#else
+  QDir stagedir(destdir);
+#endif
+  QStringList written;
+  QByteArray buffer(EXTRACTBUFSIZE, '\0');
+  ExtractResult result = Extracted;
+  bool sawEntry = false;
+
+  while(true)
+  {
+    tarHeaderBlock head;
+    int count = gzreadFully(fin, (char*)&head, sizeof(head));
+    if(count < 0)
+    {
+      result = UncompressError;
+      break;
+    }
+    if(count == 0)
+    {
+      if(!sawEntry)
+        result = UncompressError;
+      break;
+    }
+    if(count < (int)sizeof(head))
+    {
+      result = FormatError;
+      break;
+    }
+    sawEntry = true;
+
+    if(head.name[0] == '\0' && head.size[0] == '\0' && head.typeflag == '\0')
+      continue;
+
+    QString name;
+    long size = 0;
+    if(!parseHeader(head, name, size))
+    {
+      result = FormatError;
+      break;
+    }
+
+    long remaining = ((size + 511) / 512) * 512;
+    QFile fout;
+    if(head.typeflag == TYPE_REGULAR)
+    {
+      QString path = QDir::cleanPath(destdir.absoluteFilePath(name));
+      if(path.startsWith(root))
+      {
+        QString rel = path.mid(root.length());
+        fout.setFileName(stagedir.absoluteFilePath(rel));
+        stagedir.mkpath(QFileInfo(fout.fileName()).path());
+        if(!written.contains(rel))
+          written.append(rel);
+      }
+      if(fout.fileName().isEmpty() || !fout.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        result = WriteError;
+    }
+
+    while(remaining > 0)
+    {
+      int chunk = (int)qMin(remaining, (long)buffer.size());
+      count = gzreadFully(fin, buffer.data(), chunk);
+      if(count != chunk)
+      {
+        result = (count < 0) ? UncompressError : FormatError;
+        break;
+      }
+      if(fout.isOpen())
+      {
+        int data = (int)qMin((long)count, size);
+        if(fout.write(buffer.constData(), data) != data)
+          result = WriteError;
+        size -= data;
+      }
+      remaining -= chunk;
+    }
+    if(fout.isOpen())
+      fout.close();
+
+    if(result == UncompressError || result == FormatError)
+      break;
+  }
+
+  gzclose(fin);
+
+#if QT_VERSION >= 0x050000
+  /* tmpdir removes whatever is left behind when it goes out of scope */
+  for(int i = 0; result == Extracted && i < written.size(); i++)
+  {
+    QString target = destdir.absoluteFilePath(written.at(i));
+    destdir.mkpath(QFileInfo(target).path());
+    if(QFile::exists(target))
+      QFile::remove(target);
+    if(!QFile::rename(stagedir.absoluteFilePath(written.at(i)), target))
+      result = WriteError;
+  }
+#endif
+
+  return result;
+}
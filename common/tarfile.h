@@ -16,9 +16,13 @@
 
 class TarFile {
   public:
+    enum ExtractResult { Extracted, UncompressError, FormatError, WriteError };
+
     TarFile(const QByteArray &);
     virtual ~TarFile();
 
+    static ExtractResult extract(const QString &gzfile, const QString &dir);
+
     QMap<QString, QByteArray> _list;
 
     bool isValid() { return _valid; }
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "urlstream.h"
+
+#include <QCoreApplication>
+#include <QIODevice>
+#include <QVariant>
+
+#include <limits.h>
+
+#include <xsqlquery.h>
+
+#define DEBUG false
+
+#define CHUNKSIZE (1024 * 1024)
+
+/* lo_open() modes, from libpq/libpq-fs.h */
+#define INV_WRITE 0x00020000
+#define INV_READ  0x00040000
+
+/* store() can run from a file watcher while some window has its own
+   transaction open on the same connection. transaction_timestamp() only
+   equals statement_timestamp() for the first statement of a transaction,
+   so they differ when this SELECT runs inside someone else's BEGIN.
+ */
+static bool inTransaction()
+{
+  XSqlQuery txnq("SELECT transaction_timestamp() < statement_timestamp() AS intxn;");
+  return txnq.first() && txnq.value("intxn").toBool();
+}
+
+/* Abandon the work done by store() and pass \a err back. Inside someone
+   else's transaction only roll back to store()'s savepoint.
+ */
+static QSqlError rollback(const QSqlError &err, bool nested)
+{
+  XSqlQuery rollbackq;
+  if (nested)
+  {
+    rollbackq.exec("ROLLBACK TO SAVEPOINT urlstream_store;");
+    rollbackq.exec("RELEASE SAVEPOINT urlstream_store;");
+  }
+  else
+    rollbackq.exec("ROLLBACK;");
+  return err;
+}
+
+static QSqlError writeError()
+{
+  return QSqlError(QCoreApplication::translate("UrlStream",
+                                               "Could not write the file."),
+                   QString(), QSqlError::UnknownError);
+}
+
+/*! Copy the url_stream of url \a urlid to \a out. */
+QSqlError UrlStream::read(const int urlid, QIODevice &out)
+{
+  XSqlQuery lenq;
+  lenq.prepare("SELECT LENGTH(url_stream) AS length"
+               "  FROM url"
+               " WHERE (url_id=:url_id);");
+  lenq.bindValue(":url_id", urlid);
+  lenq.exec();
+  if (! lenq.first())
+    return lenq.lastError();
+
+  qint64 length = lenq.value("length").toLongLong();
+  if (DEBUG)
+    qDebug("UrlStream::read(%d) %lld bytes", urlid, length);
+
+  XSqlQuery chunkq;
+  chunkq.prepare("SELECT SUBSTRING(url_stream FROM :start FOR :length) AS chunk"
+                 "  FROM url"
+                 " WHERE (url_id=:url_id);");
+  for (qint64 offset = 0; offset < length; offset += CHUNKSIZE)
+  {
+    chunkq.bindValue(":url_id", urlid);
+    chunkq.bindValue(":start",  offset + 1);
+    chunkq.bindValue(":length", CHUNKSIZE);
+    chunkq.exec();
+    if (! chunkq.first())
+      return chunkq.lastError();
+
+    QByteArray chunk = chunkq.value("chunk").toByteArray();
+    if (chunk.isEmpty())
+      break;
+    if (out.write(chunk) != chunk.size())
+      return writeError();
+  }
+
+  return QSqlError();
+}
+
+/*! Copy the rest of \a in to a new large object. Set \a oid to it and
+    \a length to the number of bytes copied.
+
+    The chunks go through lo_open() and lowrite() inside one transaction
+    because lo_put() needs PostgreSQL 9.4 and older servers are still
+    supported. If the connection is already in a transaction, the work
+    goes in a savepoint instead so the caller's transaction is neither
+    committed nor rolled back. If anything fails the work is rolled back,
+    which removes the large object again.
+ */
+QSqlError UrlStream::store(QIODevice &in, unsigned int &oid, qint64 &length)
+{
+  oid    = 0;
+  length = 0;
+
+  bool nested = inTransaction();
+
+  XSqlQuery loq;
+  loq.exec(nested ? "SAVEPOINT urlstream_store;" : "BEGIN;");
+  if (loq.lastError().type() != QSqlError::NoError)
+    return loq.lastError();
+
+  loq.exec("SELECT lo_create(0) AS oid;");
+  if (! loq.first())
+    return rollback(loq.lastError(), nested);
+  unsigned int newoid = loq.value("oid").toUInt();
+
+  loq.prepare("SELECT lo_open(:oid, :mode) AS fd;");
+  loq.bindValue(":oid",  newoid);
+  loq.bindValue(":mode", INV_WRITE);
+  loq.exec();
+  if (! loq.first())
+    return rollback(loq.lastError(), nested);
+  int fd = loq.value("fd").toInt();
+
+  XSqlQuery writeq;
+  writeq.prepare("SELECT lowrite(:fd, :chunk);");
+  while (! in.atEnd())
+  {
+    QByteArray chunk = in.read(CHUNKSIZE);
+    if (chunk.isEmpty())
+      break;
+
+    /* loread() takes an int length */
+    if (length + chunk.size() > INT_MAX)
+      return rollback(QSqlError(QCoreApplication::translate("UrlStream",
+                                                            "The file is too large to save to the database."),
+                                QString(), QSqlError::UnknownError), nested);
+
+    writeq.bindValue(":fd",    fd);
+    writeq.bindValue(":chunk", chunk);
+    writeq.exec();
+    if (writeq.lastError().type() != QSqlError::NoError)
+      return rollback(writeq.lastError(), nested);
+    length += chunk.size();
+  }
+
+  /* in a savepoint the descriptor would stay open until the caller ends
+     its transaction */
+  loq.prepare("SELECT lo_close(:fd);");
+  loq.bindValue(":fd", fd);
+  loq.exec();
+  if (loq.lastError().type() != QSqlError::NoError)
+  {
+    length = 0;
+    return rollback(loq.lastError(), nested);
+  }
+
+  loq.exec(nested ? "RELEASE SAVEPOINT urlstream_store;" : "COMMIT;");
+  if (loq.lastError().type() != QSqlError::NoError)
+  {
+    QSqlError err = loq.lastError();
+    length = 0;
+    return rollback(err, nested);
+  }
+  oid = newoid;
+
+  if (DEBUG)
+    qDebug("UrlStream::store() %lld bytes in large object %u", length, oid);
+
+  return QSqlError();
+}
+
+/*! The SQL expression that reads back the large object written by
+    store(). Bind :streamoid and :streamlength to what store() returned.
+    loread() and lo_open() work on every supported server, unlike lo_get().
+
+    Only the client side is chunked. The server still builds the whole
+    value in memory while it runs the statement that uses this.
+ */
+QString UrlStream::streamSql()
+{
+  return QString("loread(lo_open(:streamoid, %1), :streamlength)").arg(INV_READ);
+}
+
+/*! Remove a large object created by store(). */
+void UrlStream::discard(const unsigned int oid)
+{
+  if (oid == 0)
+    return;
+
+  XSqlQuery unlinkq;
+  unlinkq.prepare("SELECT lo_unlink(:oid);");
+  unlinkq.bindValue(":oid", oid);
+  unlinkq.exec();
+}
@@ -0,0 +1,35 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __URLSTREAM_H__
+#define __URLSTREAM_H__
+
+#include <QSqlError>
+
+class QIODevice;
+
+/*
+    UrlStream moves file attachments between the url_stream column and
+    local files a chunk at a time so a large attachment never has to fit
+    in the client's memory. read() copies url_stream to a device with
+    SUBSTRING reads. store() copies a device into a temporary large
+    object on the server; use streamSql() for url_stream in the INSERT
+    or UPDATE, then discard() the large object.
+ */
+class UrlStream
+{
+  public:
+    static QSqlError read(const int urlid, QIODevice &out);
+    static QSqlError store(QIODevice &in, unsigned int &oid, qint64 &length);
+    static QString   streamSql();
+    static void      discard(const unsigned int oid);
+};
+
+#endif
@@ -10,32 +10,60 @@
 
 #include "xtsettings.h"
 
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
 #include <QSettings>
 
+/* Every window and list reads and writes its settings through here, so
+   keep one QSettings open for the life of the process instead of parsing
+   the settings file on each call. QSettings writes changes back from the
+   event loop and again when it's destroyed at exit.
+ */
+static QMutex _settingsMutex;
+
+static QSettings &xtsettings()
+{
+  static QSettings settings(QSettings::UserScope, "xTuple.com", "xTuple");
+  return settings;
+}
+
+/* The pre-xTuple settings are only read to migrate keys the first time
+   they're asked for, so don't open them until that happens.
+ */
+static QSettings &oldsettings()
+{
+  static QSettings settings(QSettings::UserScope, "OpenMFG.com", "OpenMFG");
+  return settings;
+}
+
 QVariant xtsettingsValue(const QString & key, const QVariant & defaultValue)
 {
-  QSettings settings(QSettings::UserScope, "xTuple.com", "xTuple");
-  QString key2 = key;
-  if(key.startsWith("/xTuple/"))
-    key2 = key2.replace(0, 8, QString("/OpenMFG/"));
+  static QSet<QString> notMigrated;
+
+  QMutexLocker locker(&_settingsMutex);
+
+  QSettings &settings = xtsettings();
   if(settings.contains(key))
     return settings.value(key, defaultValue);
-  else
+  else if (! notMigrated.contains(key))
   {
-    QSettings oldsettings(QSettings::UserScope, "OpenMFG.com", "OpenMFG");
-    if(oldsettings.contains(key2))
+    QString key2 = key;
+    if(key.startsWith("/xTuple/"))
+      key2 = key2.replace(0, 8, QString("/OpenMFG/"));
+    if(oldsettings().contains(key2))
     {
-      QVariant val = oldsettings.value(key2, defaultValue);
-      xtsettingsSetValue(key, val);
+      QVariant val = oldsettings().value(key2, defaultValue);
+      settings.setValue(key, val);
       return val;
     }
+    notMigrated.insert(key);
   }
   return defaultValue;
 }
 
 void xtsettingsSetValue(const QString & key, const QVariant & value)
 {
-  QSettings settings(QSettings::UserScope, "xTuple.com", "xTuple");
-  settings.setValue(key, value);
+  QMutexLocker locker(&_settingsMutex);
+  xtsettings().setValue(key, value);
 }
-
@@ -13,6 +13,7 @@
 #include <QSqlError>
 #include <QVariant>
 #include <QMessageBox>
+#include "changebus.h"
 #include "metasql.h"
 #include "mqlutil.h"
 #include "errorReporter.h"
@@ -33,7 +34,7 @@ allocateARCreditMemo::allocateARCreditMemo(QWidget* parent, const char* name, bo
   _aropen->addColumn(tr("This Alloc."),       _moneyColumn, Qt::AlignRight,  true,  "allocated");
   _aropen->addColumn(tr("Total Alloc."),      _moneyColumn, Qt::AlignRight,  true,  "totalallocated");
 
-  connect(omfgThis, SIGNAL(creditMemosUpdated()), this, SLOT(sPopulate()));
+  omfgThis->changes()->subscribe("creditmemo", this, SLOT(sPopulate()));
 
   connect(_aropen,      SIGNAL(valid(bool)),    this,           SLOT(sHandleButton()));
   connect(_allocate,	SIGNAL(clicked()),	this,           SLOT(sAllocate()));
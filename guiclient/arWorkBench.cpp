@@ -19,6 +19,7 @@
 #include "mqlutil.h"
 
 #include "cashReceipt.h"
+#include "changebus.h"
 #include "errorReporter.h"
 #include "getGLDistDate.h"
 #include "storedProcErrorLookup.h"
@@ -118,7 +119,7 @@ arWorkBench::arWorkBench(QWidget* parent, const char* name, Qt::WindowFlags fl)
   
   if(_privileges->check("PostCashReceipts"))
     connect(_cashrcpt, SIGNAL(itemSelected(int)), _editCashrcpt, SLOT(animateClick()));
-  connect(omfgThis, SIGNAL(cashReceiptsUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("cashreceipt", this, SLOT(sFillList()));
 
   if (!_metrics->boolean("CCAccept") || !_privileges->check("ProcessCreditCards"))
     _tab->removeTab(_tab->indexOf(_creditCardTab));
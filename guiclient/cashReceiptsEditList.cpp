@@ -22,6 +22,7 @@
 
 #include "guiclient.h"
 #include "cashReceipt.h"
+#include "changebus.h"
 #include "errorReporter.h"
 #include "getGLDistDate.h"
 #include "storedProcErrorLookup.h"
@@ -64,7 +65,7 @@ cashReceiptsEditList::cashReceiptsEditList(QWidget* parent, const char* name, Qt
     connect(_cashrcpt, SIGNAL(itemSelected(int)), _view, SLOT(animateClick()));
   }
 
-  connect(omfgThis, SIGNAL(cashReceiptsUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("cashreceipt", this, SLOT(sFillList()));
 
   sFillList();
 }
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "changebus.h"
+
+#include <QDebug>
+#include <QPair>
+
+#define DEBUG false
+
+ChangeBus::ChangeBus(QObject *parent)
+  : QObject(parent)
+{
+  _timer.setSingleShot(true);
+  _timer.setInterval(100);
+  connect(&_timer, SIGNAL(timeout()), this, SLOT(flush()));
+}
+
+ChangeBus::~ChangeBus()
+{
+}
+
+int ChangeBus::interval() const
+{
+  return _timer.interval();
+}
+
+/*! Set how long, in milliseconds, changes are collected before the
+    subscribers are told about them.
+ */
+void ChangeBus::setInterval(int msec)
+{
+  _timer.setInterval(msec);
+}
+
+/*! \brief Call \a member on \a receiver after documents of \a type change.
+
+  \a member is a slot taking no arguments, given with the SLOT() macro.
+  If \a id is -1 the slot is called for every change to the type,
+  otherwise only for changes to that id and for changes posted without
+  an id.
+ */
+void ChangeBus::subscribe(const QString &type, QObject *receiver, const char *member, int id)
+{
+  if (! receiver || ! member)
+    return;
+
+  // skip the code SLOT() puts in front of the signature
+  QByteArray signature = QMetaObject::normalizedSignature(member + 1);
+  int index = receiver->metaObject()->indexOfMethod(signature.constData());
+  if (index < 0)
+  {
+    qWarning() << "ChangeBus::subscribe() could not find" << signature
+               << "on" << receiver->metaObject()->className();
+    return;
+  }
+
+  Subscription sub;
+  sub.type     = type;
+  sub.id       = id;
+  sub.receiver = receiver;
+  sub.method   = receiver->metaObject()->method(index);
+  _subscriptions.append(sub);
+
+  connect(receiver, SIGNAL(destroyed(QObject*)), this, SLOT(sReceiverDestroyed(QObject*)), Qt::UniqueConnection);
+}
+
+void ChangeBus::subscribe(const QStringList &types, QObject *receiver, const char *member)
+{
+  foreach (QString type, types)
+    subscribe(type, receiver, member);
+}
+
+void ChangeBus::unsubscribe(QObject *receiver)
+{
+  for (int i = _subscriptions.size() - 1; i >= 0; i--)
+  {
+    if (_subscriptions.at(i).receiver.isNull() ||
+        _subscriptions.at(i).receiver.data() == receiver)
+      _subscriptions.removeAt(i);
+  }
+}
+
+/*! Record that the document of \a type with \a id changed, or that
+    several or unspecified documents of \a type changed if \a id is -1.
+ */
+void ChangeBus::post(const QString &type, int id)
+{
+  _pending[type].insert(id);
+  if (! _timer.isActive())
+    _timer.start();
+}
+
+/*! Deliver everything posted since the last flush. Each subscribed
+    slot runs at most once, however many of its types and ids changed.
+ */
+void ChangeBus::flush()
+{
+  _timer.stop();
+  if (_pending.isEmpty())
+    return;
+
+  QHash<QString, QSet<int> > pending = _pending;
+  _pending.clear();
+
+  if (DEBUG)
+    qDebug() << "ChangeBus::flush()" << pending.keys();
+
+  // a slot may subscribe or unsubscribe, so walk a copy
+  QList<Subscription> subscriptions = _subscriptions;
+  QSet<QPair<QObject *, int> > called;
+  foreach (Subscription sub, subscriptions)
+  {
+    if (sub.receiver.isNull() || ! pending.contains(sub.type))
+      continue;
+
+    const QSet<int> &ids = pending[sub.type];
+    if (sub.id >= 0 && ! ids.contains(sub.id) && ! ids.contains(-1))
+      continue;
+
+    QPair<QObject *, int> target(sub.receiver.data(), sub.method.methodIndex());
+    if (called.contains(target))
+      continue;
+    called.insert(target);
+
+    sub.method.invoke(sub.receiver.data(), Qt::DirectConnection);
+  }
+}
+
+void ChangeBus::sReceiverDestroyed(QObject *receiver)
+{
+  unsubscribe(receiver);
+}
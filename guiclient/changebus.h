@@ -0,0 +1,66 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __CHANGEBUS_H__
+#define __CHANGEBUS_H__
+
+#include <QHash>
+#include <QList>
+#include <QMetaMethod>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+/*
+    ChangeBus collects the document changes announced through the
+    GUIClient s*Updated slots and hands them out in batches. Windows
+    subscribe a slot to one or more document types, optionally for a
+    single id, and that slot is called at most once per batch no matter
+    how many matching changes were posted in the meantime.
+ */
+class ChangeBus : public QObject
+{
+  Q_OBJECT
+
+  public:
+    ChangeBus(QObject *parent = 0);
+    virtual ~ChangeBus();
+
+    int  interval() const;
+    void setInterval(int msec);
+
+    void subscribe(const QString &type, QObject *receiver, const char *member, int id = -1);
+    void subscribe(const QStringList &types, QObject *receiver, const char *member);
+    void unsubscribe(QObject *receiver);
+
+  public slots:
+    void post(const QString &type, int id = -1);
+    void flush();
+
+  private slots:
+    void sReceiverDestroyed(QObject *receiver);
+
+  private:
+    struct Subscription
+    {
+      QString           type;
+      int               id;
+      QPointer<QObject> receiver;
+      QMetaMethod       method;
+    };
+
+    QList<Subscription>       _subscriptions;
+    QHash<QString, QSet<int> > _pending;
+    QTimer                    _timer;
+};
+
+#endif
@@ -16,6 +16,7 @@
 #include <metasql.h>
 #include <mqlutil.h>
 
+#include "changebus.h"
 #include "contactcluster.h"
 #include "crmaccount.h"
 #include "customer.h"
@@ -219,16 +220,11 @@ contact::contact(QWidget* parent, const char* name, bool modal, Qt::WindowFlags
   connect(_uses,               SIGNAL(valid(bool)), this, SLOT(sHandleValidUse(bool)));
   connect(_uses, SIGNAL(populateMenu(QMenu*, XTreeWidgetItem*)), this, SLOT(sPopulateUsesMenu(QMenu*)));
   connect(_viewUse,                       SIGNAL(clicked()), this, SLOT(sViewUse()));
-  connect(omfgThis,         SIGNAL(crmAccountsUpdated(int)), this, SLOT(sFillList()));
-  connect(omfgThis,      SIGNAL(customersUpdated(int,bool)), this, SLOT(sFillList()));
-  connect(omfgThis,            SIGNAL(employeeUpdated(int)), this, SLOT(sFillList()));
-  connect(omfgThis,              SIGNAL(prospectsUpdated()), this, SLOT(sFillList()));
-  connect(omfgThis, SIGNAL(purchaseOrdersUpdated(int,bool)), this, SLOT(sFillList()));
-  connect(omfgThis,         SIGNAL(quotesUpdated(int,bool)), this, SLOT(sFillList()));
-  connect(omfgThis,    SIGNAL(salesOrdersUpdated(int,bool)), this, SLOT(sFillList()));
-  connect(omfgThis,      SIGNAL(transferOrdersUpdated(int)), this, SLOT(sFillList()));
-  connect(omfgThis,                SIGNAL(vendorsUpdated()), this, SLOT(sFillList()));
-  connect(omfgThis,             SIGNAL(warehousesUpdated()), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe(QStringList() << "crmaccount" << "customer"
+                                 << "employee" << "prospect" << "purchaseorder"
+                                 << "quote" << "salesorder" << "transferorder"
+                                 << "vendor" << "warehouse",
+                                 this, SLOT(sFillList()));
 
   _charass->setType("CNTCT");
 
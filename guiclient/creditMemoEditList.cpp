@@ -25,6 +25,7 @@
 #include "creditMemo.h"
 #include "creditMemoItem.h"
 #include "mqlutil.h"
+#include "changebus.h"
 #include "errorReporter.h"
 
 creditMemoEditList::creditMemoEditList(QWidget* parent, const char* name, Qt::WindowFlags fl)
@@ -45,7 +46,7 @@ creditMemoEditList::creditMemoEditList(QWidget* parent, const char* name, Qt::Wi
   _cmhead->addColumn(tr("Ext. Price"),  _moneyColumn, Qt::AlignRight, true, "extprice");
   _cmhead->addColumn(tr("Currency"), _currencyColumn, Qt::AlignLeft,  true, "currabbr");
 
-  connect(omfgThis, SIGNAL(creditMemosUpdated()), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("creditmemo", this, SLOT(sFillList()));
 
   sFillList();
 }
@@ -93,6 +93,7 @@ crmaccount::crmaccount(QWidget* parent, const char* name, Qt::WindowFlags fl)
   connect(_secondaryButton, SIGNAL(toggled(bool)), this, SLOT(sHandleButtons()));       
   connect(_allButton, SIGNAL(toggled(bool)), this, SLOT(sHandleButtons()));
   connect(_contacts, SIGNAL(cntctDetached(int)), this, SLOT(sHandleCntctDetach(int)));
+  connect(_tab, SIGNAL(currentChanged(int)), this, SLOT(sFillList()));
 
   _charass->setType("CRMACCT");
 
@@ -615,7 +616,6 @@ void crmaccount::setId(int id)
   _crmacctId = id;
   _todoList->parameterWidget()->setDefault(tr("Account"), _crmacctId, true);
   _contacts->setCrmacctid(_crmacctId);
-  _charass->setId(_crmacctId);
   sPopulate();
 
   if (cView != _mode)
@@ -662,9 +662,6 @@ void crmaccount::sPopulate()
     _secondary->setId(getq.value("crmacct_cntct_id_2").toInt());
     _notes->setText(getq.value("crmacct_notes").toString());
     _parentCrmacct->setId(getq.value("crmacct_parent_id").toInt());
-    _comments->setId(_crmacctId);
-    _documents->setId(_crmacctId);
-    _charass->setId(_crmacctId);
     _primary->setSearchAcct(_crmacctId);
     _secondary->setSearchAcct(_crmacctId);
     _owner->setUsername(getq.value("crmacct_owner_username").toString());
@@ -691,17 +688,56 @@ void crmaccount::sPopulate()
     _taxauthId    = -1;
     _username     = "";
     _vendId       = -1;
-    _comments->setId(-1);
-    _documents->setId(-1);
-    _charass->setId(-1);
     _canCreateUsers = false;
 
     sHandleChildButtons();
   }
 
-  sPopulateRegistrations();
-  _contacts->sFillList();
-  _todoList->sFillList();
+  _loaded.clear();
+  sFillList();
+}
+
+/* Only fill the tab the user is looking at. Comments, characteristics
+   and documents are filled the first time they're shown for this account
+   and kept current by the handlers that change them. Contacts, to-dos and
+   registrations also change from other windows, so they're refilled
+   every time they're shown.
+ */
+bool crmaccount::firstShow(QWidget *page)
+{
+  if (_loaded.contains(page))
+    return false;
+
+  _loaded.insert(page);
+  return true;
+}
+
+void crmaccount::sFillList()
+{
+  if (_tab->currentIndex() == _tab->indexOf(_contactsTab))
+  {
+    if (_allButton->isChecked())
+      _contacts->sFillList();
+  }
+  else if (_tab->currentIndex() == _tab->indexOf(_commentsTab))
+  {
+    if (firstShow(_commentsTab))
+      _comments->setId(_crmacctId);
+  }
+  else if (_tab->currentIndex() == _tab->indexOf(_characteristicsTab))
+  {
+    if (firstShow(_characteristicsTab))
+      _charass->setId(_crmacctId);
+  }
+  else if (_tab->currentIndex() == _tab->indexOf(_todoListTab))
+    _todoList->sFillList();
+  else if (_tab->currentIndex() == _tab->indexOf(_registrationsTab))
+    sPopulateRegistrations();
+  else if (_tab->currentIndex() == _tab->indexOf(_documentsTab))
+  {
+    if (firstShow(_documentsTab))
+      _documents->setId(_crmacctId);
+  }
 }
 
 void crmaccount::sCompetitor()
@@ -974,7 +1010,7 @@ void crmaccount::sUpdateRelationships()
                                 getq, __FILE__, __LINE__))
     return;
 
-  _contacts->sFillList();
+  sFillList();
 }
 
 void crmaccount::doDialog(QWidget *parent, const ParameterList & pParams)
@@ -1145,6 +1181,8 @@ void crmaccount::sHandleButtons()
     _widgetStack->setCurrentIndex(_widgetStack->indexOf(_secondaryPage));       
   else  
     _widgetStack->setCurrentIndex(_widgetStack->indexOf(_allPage));     
+
+  sFillList();
 }
 
 void crmaccount::sHandleChildButtons()
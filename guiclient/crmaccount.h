@@ -17,6 +17,7 @@
 #include "todoList.h"
 #include "xwidget.h"
 
+#include <QSet>
 #include <QSqlError>
 #include "ui_crmaccount.h"
 
@@ -35,6 +36,7 @@ public slots:
     virtual void sPopulate();
     virtual void sPopulateRegistrations();
     virtual void setId(int id);
+    virtual void sFillList();
 
 signals:
     int newId(int id);
@@ -68,7 +70,8 @@ protected slots:
 
 protected:
     virtual void closeEvent(QCloseEvent*);
-    
+    virtual bool firstShow(QWidget *page);
+
     todoList *_todoList;
     contacts *_contacts;
 
@@ -93,6 +96,7 @@ private:
     int         _cntct2Id;
     int         _NumberGen;
     bool        _canCreateUsers;
+    QSet<QWidget*> _loaded;
 
     QSqlError   saveNoErrorCheck(bool pInTxn = false);
 
@@ -1379,9 +1379,6 @@ void customer::populate()
     else
       _onCreditHold->setChecked(true);
     
-    _comments->setId(_crmacctid);
-    _documents->setId(_crmacctid);
-
     _todoList->parameterWidget()->setDefault(tr("Account"), _crmacctid, true);
     _contacts->setCrmacctid(_crmacctid);
 
@@ -1392,6 +1389,7 @@ void customer::populate()
     _cashreceipts->findChild<CustomerSelector*>("_customerSelector")->setCustId(_custid);
     _cctrans->findChild<CustomerSelector*>("_customerSelector")->setCustId(_custid);
 
+    _loaded.clear();
     sFillList();
 
     emit populated();
@@ -1624,22 +1622,40 @@ void customer::sMoveDown()
   sFillCcardList();
 }
 
+/* Only the page the user is looking at gets filled. Pages that this
+   window or their own update signals keep current are filled the first
+   time they're shown for this customer. The summary, contacts, to-do,
+   cash receipt and card transaction pages change from other windows
+   without telling us, so they're refilled every time they're shown.
+ */
+bool customer::firstShow(QWidget *page)
+{
+  if (_loaded.contains(page))
+    return false;
+
+  _loaded.insert(page);
+  return true;
+}
+
 void customer::sFillList()
 {
   if (_tab->currentIndex() == _tab->indexOf(_addressTab))
   {
-    if (_shiptoButton->isChecked())
+    if (_shiptoButton->isChecked() && firstShow(_shiptoPage))
       sFillShiptoList();
   }
   else if (_tab->currentIndex() == _tab->indexOf(_settingsTab))
   {
-    if (_taxButton->isChecked())
+    if (_taxButton->isChecked() && firstShow(_taxPage))
       sFillTaxregList();
-    else if (_creditcardsButton->isChecked())
+    else if (_creditcardsButton->isChecked() && firstShow(_creditcardsPage))
       sFillCcardList();
   }
   else if (_tab->currentIndex() == _tab->indexOf(_characteristicsTab))
-     sFillCharacteristicList();
+  {
+    if (firstShow(_characteristicsTab))
+      sFillCharacteristicList();
+  }
   else if (_tab->currentIndex() == _tab->indexOf(_crmTab))
   {
     if (_contactsButton->isChecked())
@@ -1651,22 +1667,32 @@ void customer::sFillList()
   {
     if (_summaryButton->isChecked())
       sPopulateSummary();
-    else if (_quotesButton->isChecked())
+    else if (_quotesButton->isChecked() && firstShow(_quotesPage))
       _quotes->sFillList();
-    else if (_ordersButton->isChecked())
+    else if (_ordersButton->isChecked() && firstShow(_ordersPage))
       _orders->sFillList();
-    else if (_returnsButton->isChecked())
+    else if (_returnsButton->isChecked() && firstShow(_returnsPage))
       _returns->sFillLists();
   }
   else if (_tab->currentIndex() == _tab->indexOf(_accountingTab))
   {
-    if (_aritemsButton->isChecked())
+    if (_aritemsButton->isChecked() && firstShow(_aritemsPage))
       _aritems->sFillList();
     else if (_cashreceiptsButton->isChecked())
       _cashreceipts->sFillList();
     else if (_cctransButton->isChecked())
       _cctrans->sFillList();
   }
+  else if (_tab->currentIndex() == _tab->indexOf(_documentsTab))
+  {
+    if (firstShow(_documentsTab))
+      _documents->setId(_crmacctid);
+  }
+  else if (_tab->currentIndex() == _tab->indexOf(_tabRemarks))
+  {
+    if (_commentsButton->isChecked() && firstShow(_commentsPage))
+      _comments->setId(_crmacctid);
+  }
 }
 
 void customer::sFillCcardList()
@@ -1949,11 +1975,9 @@ void customer::sClear()
     _cashreceipts->findChild<CustomerSelector*>("_customerSelector")->setCustId(-1);
     _cctrans->findChild<CustomerSelector*>("_customerSelector")->setCustId(-1);
 
-    _comments->setId(_crmacctid);
-    _documents->setId(_crmacctid);
-
     _print->setEnabled(false);
 
+    _loaded.clear();
     sFillList();
     _charfilled = false;
     setValid(false);
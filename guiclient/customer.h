@@ -24,6 +24,7 @@
 #include "dspCashReceipts.h"
 #include "dspCreditCardTransactions.h"
 
+#include <QSet>
 #include <QStandardItemModel>
 #include <parameter.h>
 
@@ -101,6 +102,7 @@ signals:
 protected:
     virtual void closeEvent(QCloseEvent*);
     virtual void setValid(bool valid);
+    virtual bool firstShow(QWidget *page);
     todoList *_todoList;
     contacts *_contacts;
     quotes *_quotes;
@@ -123,6 +125,7 @@ private:
     bool _autoSaved;
     bool _captive;
     bool _charfilled;
+    QSet<QWidget*> _loaded;
     QStandardItemModel * _custchar;
 
 };
@@ -22,7 +22,6 @@
 #include <QTranslator>
 
 #include <parameter.h>
-#include <gunzip.h>
 #include <tarfile.h>
 #include <xtHelp.h>
 
@@ -81,48 +80,24 @@ void dictionaries::finished(QNetworkReply * nwrep)
         {
           file.write(ba);
           file.close();
-          QByteArray data = gunzipFile(file.fileName());
-          if(!data.isEmpty())
+          #if QT_VERSION >= 0x050000
+          QString dest = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+          #else
+          QString dest = QDesktopServices::storageLocation(QDesktopServices::DataLocation);
+          #endif
+          TarFile::ExtractResult extracted = TarFile::extract(file.fileName(), dest);
+          if(extracted == TarFile::Extracted)
           {
-            TarFile *_files = new TarFile(data);
-            if(_files->isValid())
-            {
-              bool error = false;
-              QMapIterator<QString, QByteArray> i(_files->_list);
-              while (i.hasNext())
-              {
-                i.next();
-                //cout << i.key() << ": " << i.value() << endl;
-                #if QT_VERSION >= 0x050000
-                QFile ff(QStandardPaths::writableLocation(QStandardPaths::DataLocation) + "/" + i.key());
-                #else
-                QFile ff(QDesktopServices::storageLocation(QDesktopServices::DataLocation) + "/" + i.key());
-                #endif
-                if(ff.open(QIODevice::WriteOnly | QIODevice::Truncate))
-                {
-                  ff.write(i.value());
-                  ff.close();
-                }
-                else
-                {
-                  error = true;
-                }
-              }
-              if(error)
-              {
-                _label->setText(tr("Could not save one or more files."));
-              }
-              else
-              {
-                _label->setText(tr("Dictionaries downloaded."));
-                xtHelp::reload();
-              }
-            }
-            else
-            {
-              _label->setText(tr("Could not read archive format."));
-            }
-            delete _files;
+            _label->setText(tr("Dictionaries downloaded."));
+            xtHelp::reload();
+          }
+          else if(extracted == TarFile::WriteError)
+          {
+            _label->setText(tr("Could not save one or more files."));
+          }
+          else if(extracted == TarFile::FormatError)
+          {
+            _label->setText(tr("Could not read archive format."));
           }
           else
           {
@@ -29,6 +29,7 @@
 
 #include "parameterlistsetup.h"
 #include "errorReporter.h"
+#include "metasqlcache.h"
 #include "displayprivate.h"
 
 displayPrivate::displayPrivate(::display *parent)
@@ -36,6 +37,7 @@ displayPrivate::displayPrivate(::display *parent)
       _useAltId(false),
       _queryOnStartEnabled(false),
       _autoUpdateEnabled(false),
+      _autoUpdating(false),
       _filterChanged(false),
       _parent(parent)
 {
@@ -702,6 +704,19 @@ bool display::autoUpdateEnabled() const
   return _data->_autoUpdateEnabled;
 }
 
+/*! Name the result column that uniquely identifies each row so that
+    auto-update refreshes merge into the list instead of rebuilding it.
+ */
+void display::setKeyColumn(const QString &column)
+{
+  _data->_list->setKeyColumn(column);
+}
+
+QString display::keyColumn() const
+{
+  return _data->_list->keyColumn();
+}
+
 void display::sNew()
 {
 }
@@ -755,15 +770,16 @@ void display::sFillList(ParameterList pParams, bool forceSetParams)
   int itemid = _data->_list->id();
   bool ok = true;
   QString errorString;
-  MetaSQLQuery mql = MQLUtil::mqlLoad(_data->metasqlGroup, _data->metasqlName, errorString, &ok);
+  MetaSQLQuery *mql = MetaSQLCache::cache()->query(_data->metasqlGroup, _data->metasqlName, errorString, &ok);
   if(!ok)
   {
     ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Information"),
                          errorString, __FILE__, __LINE__);
     return;
   }
-  XSqlQuery xq = mql.toQuery(pParams);
-  _data->_list->populate(xq, itemid, _data->_useAltId);
+  XSqlQuery xq = mql->toQuery(pParams);
+  _data->_list->populate(xq, itemid, _data->_useAltId,
+                         _data->_autoUpdating ? XTreeWidget::Merge : XTreeWidget::Replace);
   if (xq.lastError().type() != QSqlError::NoError)
   {
     ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Information"),
@@ -781,9 +797,16 @@ void display::sAutoUpdateToggled()
 {
   bool update = _data->_autoUpdateEnabled && _data->_autoupdate->isChecked();
   if (update)
-    connect(omfgThis, SIGNAL(tick()), this, SLOT(sFillList()));
+    connect(omfgThis, SIGNAL(tick()), this, SLOT(sAutoUpdate()));
   else
-    disconnect(omfgThis, SIGNAL(tick()), this, SLOT(sFillList()));
+    disconnect(omfgThis, SIGNAL(tick()), this, SLOT(sAutoUpdate()));
+}
+
+void display::sAutoUpdate()
+{
+  _data->_autoUpdating = true;
+  sFillList();
+  _data->_autoUpdating = false;
 }
 
 ParameterList display::getParams()
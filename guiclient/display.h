@@ -61,6 +61,9 @@ public:
     Q_INVOKABLE void setAutoUpdateEnabled(bool);
     Q_INVOKABLE bool autoUpdateEnabled() const;
 
+    Q_INVOKABLE void setKeyColumn(const QString &);
+    Q_INVOKABLE QString keyColumn() const;
+
     Q_INVOKABLE XTreeWidget * list();
     Q_INVOKABLE ParameterWidget * parameterWidget();
     Q_INVOKABLE QWidget * optionsWidget();
@@ -101,6 +104,7 @@ protected:
 protected slots:
     virtual void languageChange();
     virtual void sAutoUpdateToggled();
+    virtual void sAutoUpdate();
 
 signals:
     void fillList();
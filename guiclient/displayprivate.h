@@ -38,6 +38,7 @@ class displayPrivate : public QObject, public Ui::display
     bool _useAltId;
     bool _queryOnStartEnabled;
     bool _autoUpdateEnabled;
+    bool _autoUpdating;
     bool _filterChanged;
 
     QAction *_newAct;
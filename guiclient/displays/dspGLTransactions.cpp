@@ -99,6 +99,7 @@ dspGLTransactions::dspGLTransactions(QWidget* parent, const char*, Qt::WindowFla
   list()->addColumn(tr("Posted"),    _ynColumn,      Qt::AlignCenter, false, "gltrans_posted");
   list()->addColumn(tr("Username"),  _userColumn,    Qt::AlignLeft,   false, "gltrans_username");
   list()->addColumn(tr("Running Total"), _moneyColumn, Qt::AlignRight,false,"running");
+  list()->setPopulateLazy(true);
 
   _beginningBalance->setPrecision(omfgThis->moneyVal());
 
@@ -13,6 +13,7 @@
 #include <QMenu>
 #include <QMessageBox>
 
+#include "changebus.h"
 #include "errorReporter.h"
 #include "salesOrder.h"
 #include "storedProcErrorLookup.h"
@@ -38,7 +39,7 @@ dspQuotesByCustomer::dspQuotesByCustomer(QWidget* parent, const char*, Qt::Windo
   list()->addColumn(tr("Cust. P/O #"), 200,          Qt::AlignLeft,   true,  "quhead_custponumber"   );
   list()->addColumn(tr("Status"),     _statusColumn,  Qt::AlignCenter, true,  "quhead_status" );
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList())  );
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
 }
 
 void dspQuotesByCustomer::languageChange()
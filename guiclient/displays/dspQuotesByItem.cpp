@@ -14,6 +14,7 @@
 #include <QMenu>
 #include <QMessageBox>
 
+#include "changebus.h"
 #include "salesOrder.h"
 
 dspQuotesByItem::dspQuotesByItem(QWidget* parent, const char*, Qt::WindowFlags fl)
@@ -38,7 +39,7 @@ dspQuotesByItem::dspQuotesByItem(QWidget* parent, const char*, Qt::WindowFlags f
   list()->addColumn(tr("Status"),     _statusColumn,  Qt::AlignCenter, true,  "quhead_status" );
   list()->addColumn(tr("Quoted"),     _qtyColumn,     Qt::AlignRight,  true,  "quitem_qtyord"  );
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList())); 
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
 }
 
 void dspQuotesByItem::languageChange()
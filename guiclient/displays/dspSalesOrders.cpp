@@ -13,6 +13,7 @@
 #include <QMessageBox>
 #include <QVariant>
 
+#include "changebus.h"
 #include "copySalesOrder.h"
 #include "dspSalesOrderStatus.h"
 #include "dspShipmentsBySalesOrder.h"
@@ -58,7 +59,7 @@ dspSalesOrders::dspSalesOrders(QWidget* parent, const char*, Qt::WindowFlags fl)
   list()->addColumn(tr("Ship-to"),     -1,           Qt::AlignLeft,   true,  "cohead_shiptoname"   );
   list()->addColumn(tr("Cust. P/O #"), 200,          Qt::AlignLeft,   true,  "cohead_custponumber"   );
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList())  );
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
 }
 
 void dspSalesOrders::languageChange()
@@ -15,6 +15,7 @@
 #include <QMessageBox>
 #include <QVariant>
 
+#include "changebus.h"
 #include "guiclient.h"
 #include "copySalesOrder.h"
 #include "dspSalesOrderStatus.h"
@@ -51,7 +52,7 @@ dspSalesOrdersByItem::dspSalesOrdersByItem(QWidget* parent, const char*, Qt::Win
   list()->addColumn(tr("Inv. Returned"),   _qtyColumn,   Qt::AlignRight,  false, "invqtyreturned"  );
   list()->addColumn(tr("Inv. Balance"),    _qtyColumn,   Qt::AlignRight,  false, "invqtybalance"  );
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
 }
 
 void dspSalesOrdersByItem::languageChange()
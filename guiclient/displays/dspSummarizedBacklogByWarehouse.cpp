@@ -18,6 +18,7 @@
 #include <metasql.h>
 #include <openreports.h>
 
+#include "changebus.h"
 #include "guiclient.h"
 #include "dspInventoryAvailabilityBySalesOrder.h"
 #include "salesOrder.h"
@@ -65,7 +66,7 @@ dspSummarizedBacklogByWarehouse::dspSummarizedBacklogByWarehouse(QWidget* parent
     _showPrices->setEnabled(false);
   sHandlePrices(_showPrices->isChecked());
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
 
   sFillList();
 }
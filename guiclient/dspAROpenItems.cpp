@@ -45,6 +45,7 @@
 #include "salesOrder.h"
 #include "storedProcErrorLookup.h"
 
+#include "changebus.h"
 #include "errorReporter.h"
 
 dspAROpenItems::dspAROpenItems(QWidget* parent, const char*, Qt::WindowFlags fl)
@@ -98,8 +99,8 @@ dspAROpenItems::dspAROpenItems(QWidget* parent, const char*, Qt::WindowFlags fl)
   list()->addColumn(tr("Credit Card"),            -1, Qt::AlignLeft,   false, "ccard_number");
   list()->addColumn(tr("Notes"),                  -1, Qt::AlignLeft,   false, "notes");
   
-  connect(omfgThis, SIGNAL(creditMemosUpdated()), this, SLOT(sFillList()));
-  connect(omfgThis, SIGNAL(invoicesUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe(QStringList() << "invoice" << "creditmemo",
+                                 this, SLOT(sFillList()));
 
   disconnect(newAction(), SIGNAL(triggered()), this, SLOT(sNew()));
   connect(newAction(), SIGNAL(triggered()), this, SLOT(sCreateInvoice()));
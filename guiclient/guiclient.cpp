@@ -29,6 +29,8 @@
 #include <QCloseEvent>
 #include <QDesktopWidget>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QtConcurrentRun>
 #include <QScriptEngine>
 #include <QScriptValue>
 #include <QBuffer>
@@ -49,7 +51,9 @@
 #include "errorLog.h"
 #include "errorReporter.h"
 #include "login2.h"
+#include "notifycache.h"
 #include "storedProcErrorLookup.h"
+#include "urlstream.h"
 
 #include "systemMessage.h"
 #include "menuProducts.h"
@@ -63,6 +67,7 @@
 #include "menuWindow.h"
 #include "menuSystem.h"
 
+#include "changebus.h"
 #include "timeoutHandler.h"
 #include "idleShutdown.h"
 #include "inputManager.h"
@@ -72,6 +77,7 @@
 #include "documents.h"
 #include "splashconst.h"
 #include "scripttoolbox.h"
+#include "scriptenginepool.h"
 #include "menubutton.h"
 #include "guiErrorCheck.h"
 #include "xtupleguiclientinterface.h"
@@ -303,6 +309,13 @@ void Action::init(QWidget *pParent, const char *pName, const QString &pDisplayNa
   */
 GUIClient *omfgThis;
 
+// lets ScriptEnginePool give warm engines the same globals as a window's
+static void loadPooledScriptGlobals(QScriptEngine *engine)
+{
+  if (omfgThis)
+    omfgThis->loadScriptGlobals(engine);
+}
+
 /** @brief Create a new xTuple ERP main application window, set up menus,
            and otherwise initialize the application.
 
@@ -322,18 +335,22 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
 
   __saveSizePositionEventFilter = new SaveSizePositionEventFilter(this);
 
-  _splash->showMessage(tr("Initializing Internal Data"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(tr("Initializing Internal Data"));
 
   _showTopLevel = true;
   if(_preferences->value("InterfaceWindowOption") == "Workspace")
     _showTopLevel = false;
 
-  _GGUIClient.exec("SELECT startOfTime() AS sot, endOfTime() AS eot;");
+  // usr_window isn't needed until the menus are built but costs nothing here
+  QString usrWindow;
+  _GGUIClient.exec("SELECT startOfTime() AS sot, endOfTime() AS eot,"
+                   "       (SELECT usr_window FROM usr"
+                   "         WHERE (usr_username=getEffectiveXtUser())) AS usr_window;");
   if (_GGUIClient.first())
   {
     _startOfTime = _GGUIClient.value("sot").toDate();
     _endOfTime = _GGUIClient.value("eot").toDate();
+    usrWindow = _GGUIClient.value("usr_window").toString();
   }
   else
     ErrorReporter::error(QtCriticalMsg, this, tr("Critical Error"),
@@ -378,10 +395,11 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
   _inputManager = new InputManager();
   qApp->installEventFilter(_inputManager);
 
+  _changes = new ChangeBus(this);
+
   setWindowTitle();
 
-  _splash->showMessage(tr("Loading the Background Image"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(tr("Loading the Background Image"));
 
   if (_preferences->value("BackgroundImageid").toInt() > 0)
   {
@@ -399,8 +417,7 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
     }
   }
 
-  _splash->showMessage(tr("Initializing Internal Timers"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(tr("Initializing Internal Timers"));
 
   _eventButton = NULL;
   _registerButton = NULL;
@@ -427,9 +444,9 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
   XComboBox::_guiClientInterface = VirtualClusterLineEdit::_guiClientInterface;
   XTextEdit::_guiClientInterface = VirtualClusterLineEdit::_guiClientInterface;
   XTextEditHighlighter::_guiClientInterface = VirtualClusterLineEdit::_guiClientInterface;
+  ScriptEnginePool::pool()->setInitializer(loadPooledScriptGlobals);
 
-  _splash->showMessage(tr("Completing Initialization"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(tr("Completing Initialization"));
   _splash->finish(this);
 
   //Restore Window Size Saved on Close
@@ -478,7 +495,12 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
   _fileWatcher = new QFileSystemWatcher();
   connect(_fileWatcher, SIGNAL(fileChanged(QString)), this, SLOT(handleDocument(QString)));
 
-  hunspell_initialize();
+  // the dictionary loads in the background the first time a spell check is asked for
+  _spellCodec       = 0;
+  _spellChecker     = 0;
+  _spellLoadStarted = false;
+  _spellReady       = false;
+  connect(&_spellLoader, SIGNAL(finished()), this, SLOT(sSpellCheckerLoaded()));
 
   // load plugins before building the menus
   // TODO? add a step later to add to the menus from the plugins?
@@ -498,15 +520,9 @@ GUIClient::GUIClient(const QString &pDatabaseURL, const QString &pUsername)
   }
 
 //  Populate the menu bar
-  XSqlQuery window;
-  window.prepare("SELECT usr_window "
-                 "  FROM usr "
-                 " WHERE (usr_username=getEffectiveXtUser());");
-  window.exec();
+  startupStage(tr("Building Menus"));
   // keep synchronized with user.ui.h
-  _singleWindow = "";
-  if (window.first())
-    _singleWindow = window.value("usr_window").toString();
+  _singleWindow = usrWindow;
   if (_singleWindow.isEmpty())
     initMenuBar();
   else
@@ -962,6 +978,7 @@ void GUIClient::sTick()
   else if (! QSqlDatabase::database().isOpen())
   {
     emit dbConnectionLost();
+    NotifyCache::connectionLost();
     if (QMessageBox::question(this, tr("Database disconnected"),
                               tr("It appears that you have been disconnected from the "
                                  "database. Select Yes to try to reconnect or "
@@ -1085,6 +1102,17 @@ void GUIClient::sSystemMessageAdded()
     connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList()));
     @endcode
 
+    Each slot also posts the change to the ChangeBus returned by changes().
+    Windows that simply re-query can subscribe there instead. The bus
+    collects changes for a moment and then calls each subscribed slot
+    once, however many matching changes arrived:
+
+    @code
+    // in dspAROpenItems::dspAROpenItems()
+    omfgThis->changes()->subscribe(QStringList() << "invoice" << "creditmemo",
+                                   this, SLOT(sFillList()));
+    @endcode
+
     @note These slots can only be used to notify other windows in the
     same application instance. They do not notify other running programs
     on the same or other workstations.
@@ -1100,18 +1128,21 @@ void GUIClient::sSystemMessageAdded()
   */
 void GUIClient::sItemsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("item", pItemid);
   emit itemsUpdated(pItemid, pLocal);
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Itemsites has changed. */
 void GUIClient::sItemsitesUpdated()
 {
+  _changes->post("itemsite");
   emit itemsitesUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Sites or Warehouses has changed. */
 void GUIClient::sWarehousesUpdated()
 {
+  _changes->post("warehouse");
   emit warehousesUpdated();
 }
 
@@ -1121,6 +1152,7 @@ void GUIClient::sWarehousesUpdated()
   */
 void GUIClient::sContractsUpdated(int pContrctid, bool pLocal)
 {
+  _changes->post("contract", pContrctid);
   emit contractsUpdated(pContrctid, pLocal);
 }
 
@@ -1130,6 +1162,7 @@ void GUIClient::sContractsUpdated(int pContrctid, bool pLocal)
   */
 void GUIClient::sCustomersUpdated(int pCustid, bool pLocal)
 {
+  _changes->post("customer", pCustid);
   emit customersUpdated(pCustid, pLocal);
 }
 
@@ -1138,36 +1171,42 @@ void GUIClient::sCustomersUpdated(int pCustid, bool pLocal)
   */
 void GUIClient::sEmployeeUpdated(int id)
 {
+  _changes->post("employee", id);
   emit employeeUpdated(id);
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more G/L Series has changed. */
 void GUIClient::sGlSeriesUpdated()
 {
+  _changes->post("glseries");
   emit glSeriesUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Vendors has changed. */
 void GUIClient::sVendorsUpdated()
 {
+  _changes->post("vendor");
   emit vendorsUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Prospects has changed. */
 void GUIClient::sProspectsUpdated()
 {
+  _changes->post("prospect");
   emit prospectsUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Return Authorizations has changed. */
 void GUIClient::sReturnAuthorizationsUpdated()
 {
+  _changes->post("returnauthorization");
   emit returnAuthorizationsUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Standard Periods has changed. */
 void GUIClient::sStandardPeriodsUpdated()
 {
+  _changes->post("standardperiod");
   emit standardPeriodsUpdated();
 }
 
@@ -1176,6 +1215,7 @@ void GUIClient::sStandardPeriodsUpdated()
   */
 void GUIClient::sSalesOrdersUpdated(int pSoheadid)
 {
+  _changes->post("salesorder", pSoheadid);
   emit salesOrdersUpdated(pSoheadid, true);
 }
 
@@ -1184,12 +1224,14 @@ void GUIClient::sSalesOrdersUpdated(int pSoheadid)
   */
 void GUIClient::sSalesRepUpdated(int id)
 {
+  _changes->post("salesrep", id);
   emit salesRepUpdated(id);
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Credit Memos has changed. */
 void GUIClient::sCreditMemosUpdated()
 {
+  _changes->post("creditmemo");
   emit creditMemosUpdated();
 }
 
@@ -1197,6 +1239,7 @@ void GUIClient::sCreditMemosUpdated()
     @param pQuheadid the internal id of the Quote that changed or -1 for multiple or unspecified Quotes */
 void GUIClient::sQuotesUpdated(int pQuheadid)
 {
+  _changes->post("quote", pQuheadid);
   emit quotesUpdated(pQuheadid, true);
 }
 
@@ -1207,6 +1250,7 @@ void GUIClient::sQuotesUpdated(int pQuheadid)
   */
 void GUIClient::sWorkOrderMaterialsUpdated(int pWoid, int pWomatlid, bool pLocal)
 {
+  _changes->post("workordermaterial", pWoid);
   emit workOrderMaterialsUpdated(pWoid, pWomatlid, pLocal);
 }
 
@@ -1218,6 +1262,7 @@ void GUIClient::sWorkOrderMaterialsUpdated(int pWoid, int pWomatlid, bool pLocal
   */
 void GUIClient::sWorkOrderOperationsUpdated(int pWoid, int pWooperid, bool pLocal)
 {
+  _changes->post("workorderoperation", pWoid);
   emit workOrderOperationsUpdated(pWoid, pWooperid, pLocal);
 }
 
@@ -1227,6 +1272,7 @@ void GUIClient::sWorkOrderOperationsUpdated(int pWoid, int pWooperid, bool pLoca
   */
 void GUIClient::sWorkOrdersUpdated(int pWoid, bool pLocal)
 {
+  _changes->post("workorder", pWoid);
   emit workOrdersUpdated(pWoid, pLocal);
 }
 
@@ -1236,6 +1282,7 @@ void GUIClient::sWorkOrdersUpdated(int pWoid, bool pLocal)
   */
 void GUIClient::sPurchaseOrdersUpdated(int pPoheadid, bool pLocal)
 {
+  _changes->post("purchaseorder", pPoheadid);
   emit purchaseOrdersUpdated(pPoheadid, pLocal);
 }
 
@@ -1246,18 +1293,21 @@ void GUIClient::sPurchaseOrdersUpdated(int pPoheadid, bool pLocal)
   */
 void GUIClient::sPurchaseOrderReceiptsUpdated()
 {
+  _changes->post("receipt");
   emit purchaseOrderReceiptsUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Purchase Requests has changed. */
 void GUIClient::sPurchaseRequestsUpdated()
 {
+  _changes->post("purchaserequest");
   emit purchaseRequestsUpdated();
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Vouchers has changed. */
 void GUIClient::sVouchersUpdated()
 {
+  _changes->post("voucher");
   emit vouchersUpdated();
 }
 
@@ -1267,6 +1317,7 @@ void GUIClient::sVouchersUpdated()
   */
 void GUIClient::sBOMsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("bom", pItemid);
   emit bomsUpdated(pItemid, pLocal);
 }
 
@@ -1276,6 +1327,7 @@ void GUIClient::sBOMsUpdated(int pItemid, bool pLocal)
   */
 void GUIClient::sBBOMsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("bbom", pItemid);
   emit bbomsUpdated(pItemid, pLocal);
 }
 
@@ -1285,6 +1337,7 @@ void GUIClient::sBBOMsUpdated(int pItemid, bool pLocal)
   */
 void GUIClient::sBOOsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("boo", pItemid);
   emit boosUpdated(pItemid, pLocal);
 }
 
@@ -1294,17 +1347,20 @@ void GUIClient::sBOOsUpdated(int pItemid, bool pLocal)
  */
 void GUIClient::sBudgetsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("budget", pItemid);
   emit budgetsUpdated(pItemid, pLocal);
 }
 
 void GUIClient::sAssortmentsUpdated(int pItemid, bool pLocal)
 {
+  _changes->post("assortment", pItemid);
   emit assortmentsUpdated(pItemid, pLocal);
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Work Centers has changed. */
 void GUIClient::sWorkCentersUpdated()
 {
+  _changes->post("workcenter");
   emit workCentersUpdated();
 }
 
@@ -1314,6 +1370,7 @@ void GUIClient::sWorkCentersUpdated()
   */
 void GUIClient::sBillingSelectionUpdated(int pCoheadid, int pCoitemid)
 {
+  _changes->post("billingselection", pCoheadid);
   emit billingSelectionUpdated(pCoheadid, pCoitemid);
 }
 
@@ -1323,6 +1380,7 @@ void GUIClient::sBillingSelectionUpdated(int pCoheadid, int pCoitemid)
   */
 void GUIClient::sInvoicesUpdated(int pInvcheadid, bool pLocal)
 {
+  _changes->post("invoice", pInvcheadid);
   emit invoicesUpdated(pInvcheadid, pLocal);
 }
 
@@ -1332,6 +1390,7 @@ void GUIClient::sInvoicesUpdated(int pInvcheadid, bool pLocal)
  */
 void GUIClient::sItemGroupsUpdated(int pItemgrpid, bool pLocal)
 {
+  _changes->post("itemgroup", pItemgrpid);
   emit itemGroupsUpdated(pItemgrpid, pLocal);
 }
 
@@ -1341,12 +1400,14 @@ void GUIClient::sItemGroupsUpdated(int pItemgrpid, bool pLocal)
  */
 void GUIClient::sCashReceiptsUpdated(int pCashrcptid, bool pLocal)
 {
+  _changes->post("cashreceipt", pCashrcptid);
   emit cashReceiptsUpdated(pCashrcptid, pLocal);
 }
 
 /** @brief This slot tells other open windows the definition or status of one or more Bank Accounts has changed. */
 void GUIClient::sBankAccountsUpdated()
 {
+  _changes->post("bankaccount");
   emit bankAccountsUpdated();
 }
 
@@ -1355,6 +1416,7 @@ void GUIClient::sBankAccountsUpdated()
   */
 void GUIClient::sBankAdjustmentsUpdated(int pBankadjid, bool pLocal)
 {
+  _changes->post("bankadjustment", pBankadjid);
   emit bankAdjustmentsUpdated(pBankadjid, pLocal);
 }
 
@@ -1364,6 +1426,7 @@ void GUIClient::sBankAdjustmentsUpdated(int pBankadjid, bool pLocal)
   */
 void GUIClient::sQOHChanged(int pItemsiteid, bool pLocal)
 {
+  _changes->post("qoh", pItemsiteid);
   emit qohChanged(pItemsiteid, pLocal);
 }
 
@@ -1373,6 +1436,7 @@ void GUIClient::sQOHChanged(int pItemsiteid, bool pLocal)
   */
 void GUIClient::sReportsChanged(int pReportid, bool pLocal)
 {
+  _changes->post("report", pReportid);
   emit reportsChanged(pReportid, pLocal);
 }
 
@@ -1383,6 +1447,8 @@ void GUIClient::sReportsChanged(int pReportid, bool pLocal)
   */
 void GUIClient::sChecksUpdated(int pBankaccntid, int pCheckid, bool pLocal)
 {
+  _changes->post("check", pBankaccntid);
+  _changes->post("payment", pBankaccntid);
   emit checksUpdated(pBankaccntid, pCheckid, pLocal);
   emit paymentsUpdated(pBankaccntid, -1, pLocal);
 }
@@ -1394,12 +1460,14 @@ void GUIClient::sChecksUpdated(int pBankaccntid, int pCheckid, bool pLocal)
   */
 void GUIClient::sPaymentsUpdated(int pBankaccntid, int pApselectid, bool pLocal)
 {
+  _changes->post("payment", pBankaccntid);
   emit paymentsUpdated(pBankaccntid, pApselectid, pLocal);
 }
 
 /** @brief This slot tells other open windows the G/L Configuration has changed. */
 void GUIClient::sConfigureGLUpdated()
 {
+  _changes->post("configuregl");
   emit configureGLUpdated();
 }
 
@@ -1408,6 +1476,7 @@ void GUIClient::sConfigureGLUpdated()
   */
 void GUIClient::sProjectsUpdated(int prjid)
 {
+  _changes->post("project", prjid);
   emit projectsUpdated(prjid);
 }
 
@@ -1416,6 +1485,7 @@ void GUIClient::sProjectsUpdated(int prjid)
  */
 void GUIClient::sCrmAccountsUpdated(int crmacctid)
 {
+  _changes->post("crmaccount", crmacctid);
   emit crmAccountsUpdated(crmacctid);
 }
 
@@ -1424,6 +1494,7 @@ void GUIClient::sCrmAccountsUpdated(int crmacctid)
   */
 void GUIClient::sTaxAuthsUpdated(int taxauthid)
 {
+  _changes->post("taxauth", taxauthid);
   emit taxAuthsUpdated(taxauthid);
 }
 
@@ -1432,6 +1503,7 @@ void GUIClient::sTaxAuthsUpdated(int taxauthid)
   */
 void GUIClient::sTransferOrdersUpdated(int id)
 {
+  _changes->post("transferorder", id);
   emit transferOrdersUpdated(id);
 }
 
@@ -1440,6 +1512,7 @@ void GUIClient::sTransferOrdersUpdated(int id)
   */
 void GUIClient::sUserUpdated(QString username)
 {
+  _changes->post("user");
   emit userUpdated(username);
 }
 /** @} */
@@ -1558,6 +1631,38 @@ void resetMessage()
   qApp->processEvents();
 }
 
+/** @brief Show the next login step on the splash screen and log how long
+           the previous step took.
+
+    Each call closes the step started by the previous call, so the log ends
+    up with one "startup:" line per step plus a running total. Pass an empty
+    string once the application is ready to close the last step.
+
+    @param pStage the splash screen message for the step that is starting
+  */
+void startupStage(const QString &pStage)
+{
+  static QElapsedTimer total;
+  static qint64        stageStart = 0;
+  static QString       stage;
+
+  if (! total.isValid())
+    total.start();
+  else if (! stage.isEmpty())
+  {
+    qint64 now = total.elapsed();
+    qDebug("startup: %s took %lld ms (%lld ms total)", qPrintable(stage),
+           now - stageStart, now);
+  }
+
+  stage      = pStage;
+  stageStart = total.elapsed();
+
+  if (! pStage.isEmpty() && _splash)
+    _splash->showMessage(pStage, SplashTextAlignment, SplashTextColor);
+  qApp->processEvents();
+}
+
 /** @brief Give an audio indicator that an event has been accepted. */
 void audioAccept()
 {
@@ -2358,7 +2463,6 @@ bool GUIClient::removeDocumentWatch(QString path)
 
 void GUIClient::handleDocument(QString path)
 {
-  QByteArray  bytarr;
   QFile sourceFile(path);
   bool opened = false;
 
@@ -2385,19 +2489,47 @@ void GUIClient::handleDocument(QString path)
 
   int id = _fileMap.value(path);
 
-  bytarr = sourceFile.readAll();
-  XSqlQuery qry;
-  qry.prepare( "UPDATE url SET url_stream = :stream "
-               "WHERE (url_id = :id);" );
-  qry.bindValue(":id", id);
-  qry.bindValue(":stream", bytarr);
-  qry.exec();
+  unsigned int streamoid = 0;
+  qint64 streamlength = 0;
+  QSqlError err = UrlStream::store(sourceFile, streamoid, streamlength);
+  if (err.type() == QSqlError::NoError)
+  {
+    XSqlQuery qry;
+    qry.prepare( "UPDATE url SET url_stream = " + UrlStream::streamSql() +
+                 " WHERE (url_id = :id);" );
+    qry.bindValue(":id", id);
+    qry.bindValue(":streamoid", streamoid);
+    qry.bindValue(":streamlength", (int)streamlength);
+    qry.exec();
+    err = qry.lastError();
+    UrlStream::discard(streamoid);
+  }
+
+  /* keep watching so the next save tries again */
+  if (err.type() != QSqlError::NoError)
+    ErrorReporter::error(QtCriticalMsg, this, tr("Error Saving File"),
+                         tr("<p>Your changes to %1 could not be saved to "
+                            "the database.</p>").arg(path),
+                         err, __FILE__, __LINE__);
   addDocumentWatch(path, id);
 }
 
+/* Parsing the .dic file takes long enough to notice so it happens on a
+   worker thread. Nothing else touches the Hunspell object until
+   sSpellCheckerLoaded() hands it to the GUI thread.
+ */
+static Hunspell *loadSpellChecker(const QByteArray aff, const QByteArray dic,
+                                  const QByteArray userDic)
+{
+  Hunspell *checker = new Hunspell(aff, dic);
+  if (! userDic.isEmpty())
+    checker->add_dic(userDic);
+  return checker;
+}
+
 void GUIClient::hunspell_initialize()
 {
-    _spellReady = false;
+    _spellLoadStarted = true;
     QString langName = QLocale::languageToString(QLocale().language());
     QString appPath("/usr/lib/postbooks");
     if (! QFile::exists(appPath))
@@ -2413,31 +2545,46 @@ void GUIClient::hunspell_initialize()
       affFile.setFileName(fullPathWithoutExt + tr(".aff"));
       dicFile.setFileName(fullPathWithoutExt + tr(".dic"));
     }
-    if(affFile.exists() && dicFile.exists())
-    {
-      _spellReady = true;
-    }
-    _spellChecker = new Hunspell(QString(fullPathWithoutExt+tr(".aff")).toLatin1(),
-                                 QString(fullPathWithoutExt+tr(".dic")).toLatin1());
+    if(!(affFile.exists() && dicFile.exists()))
+      return;
+
+    QString homePath = QDir::homePath().toLatin1();
+    QByteArray userDic;
+    if(QFile::exists(homePath + tr("/xTuple/user.dic")))
+      userDic = QString(homePath + tr("/xTuple/user.dic")).toLatin1();
+
+    _spellLoader.setFuture(QtConcurrent::run(loadSpellChecker,
+                                             QString(fullPathWithoutExt+tr(".aff")).toLatin1(),
+                                             QString(fullPathWithoutExt+tr(".dic")).toLatin1(),
+                                             userDic));
+}
+
+void GUIClient::sSpellCheckerLoaded()
+{
+    _spellChecker = _spellLoader.result();
 
     QString spell_encoding = QString(_spellChecker->get_dic_encoding());
     _spellCodec = QTextCodec::codecForName(spell_encoding.toLocal8Bit());
+    if (! _spellCodec)
+      return;
 
-    QString homePath = QDir::homePath().toLatin1();
-    if(_spellReady)
-    {
-        QFile file(homePath + tr("/xTuple/user.dic"));
-        if(file.exists(homePath + tr("/xTuple/user.dic")))
-        {
-           //open user dictionary if exists
-           _spellChecker->add_dic(QString(homePath + tr("/xTuple/user.dic")).toLatin1());
-        }
-    }
+    _spellReady = true;
+    emit spellCheckerReady();
 }
 
 void GUIClient::hunspell_uninitialize()
 {
+    if (_spellLoadStarted)
+    {
+      /* a finished() still on its way must not hand us the checker
+         after it's been deleted */
+      disconnect(&_spellLoader, SIGNAL(finished()), this, SLOT(sSpellCheckerLoaded()));
+      _spellLoader.waitForFinished();
+      if (! _spellChecker && _spellLoader.future().resultCount() > 0)
+        _spellChecker = _spellLoader.result();
+    }
     delete (Hunspell *)(_spellChecker);
+    _spellChecker = 0;
     QString homePath = QDir::homePath().toLatin1();
     QFile file(homePath + tr("/xTuple/user.dic"));
 
@@ -2481,15 +2628,20 @@ void GUIClient::hunspell_uninitialize()
          file.close();
       }
     }
+    _spellReady = false;
 }
 
 bool GUIClient::hunspell_ready()
 {
+       if (! _spellLoadStarted)
+         hunspell_initialize();
        return _spellReady;
 }
 
 int GUIClient::hunspell_check(const QString word)
 {
+      if (! _spellReady)
+        return 1;
       QByteArray encodedString = _spellCodec->fromUnicode(word);
       return _spellChecker->spell(encodedString.data());
 }
@@ -2498,6 +2650,8 @@ const QStringList GUIClient::hunspell_suggest(const QString word)
 {
     char **wlst;
     QStringList wordList;
+    if (! _spellReady)
+      return wordList;
     QByteArray encodedString = _spellCodec->fromUnicode(word);
     if(_spellChecker->spell(encodedString.data()) < 1)
     {
@@ -2514,6 +2668,8 @@ const QStringList GUIClient::hunspell_suggest(const QString word)
 
 int GUIClient::hunspell_add(const QString word)
 {
+    if (! _spellReady)
+      return 0;
     QByteArray encodedString = _spellCodec->fromUnicode(word);
     //check if word has been added before
     if(!_spellAddWords.contains(encodedString.data()))
@@ -2523,6 +2679,8 @@ int GUIClient::hunspell_add(const QString word)
 
 int GUIClient::hunspell_ignore(const QString word)
 {
+    if (! _spellReady)
+      return 0;
     QByteArray encodedString = _spellCodec->fromUnicode(word);
     return _spellChecker->add(encodedString.data());
 }
@@ -13,6 +13,7 @@
 
 #include <QAction>
 #include <QDate>
+#include <QFutureWatcher>
 #include <QMainWindow>
 #include <QTimer>
 
@@ -51,6 +52,7 @@ class menuAccounting;
 class menuWindow;
 class menuSystem;
 
+class ChangeBus;
 class TimeoutHandler;
 class InputManager;
 class ReportHandler;
@@ -91,6 +93,7 @@ int  systemError(QWidget *, const QString &);
 int  systemError(QWidget *, const QString &, const QString &, const int);
 void message(const QString &, int = 0);
 void resetMessage();
+void startupStage(const QString &);
 void audioAccept();
 void audioReject();
 QString translationFile(const QString localestr, const QString component);
@@ -180,6 +183,7 @@ class GUIClient : public QMainWindow
 
     Q_INVOKABLE inline QMdiArea *workspace()           { return _workspace;    }
     Q_INVOKABLE inline InputManager *inputManager()    { return _inputManager; }
+                inline ChangeBus *changes()            { return _changes;      }
     Q_INVOKABLE inline QString databaseURL()           { return _databaseURL;  }
     Q_INVOKABLE inline QString username()              { return _username;     }
 
@@ -326,6 +330,7 @@ class GUIClient : public QMainWindow
 
     void messageNotify();
     void dbConnectionLost();
+    void spellCheckerReady();
 
     /** @name Data Update Signals
      
@@ -406,6 +411,7 @@ class GUIClient : public QMainWindow
     void handleDocument(QString path);
     void hunspell_initialize();
     void hunspell_uninitialize();
+    void sSpellCheckerLoaded();
 
   private:
     QMdiArea   *_workspace;
@@ -420,6 +426,7 @@ class GUIClient : public QMainWindow
     QMenuBar	*_menuBar;
 
     InputManager   *_inputManager;
+    ChangeBus      *_changes;
 
     menuProducts    *productsMenu;
     menuInventory   *inventoryMenu;
@@ -462,6 +469,8 @@ class GUIClient : public QMainWindow
     QMap<QString, int> _fileMap;
     QTextCodec * _spellCodec;
     Hunspell * _spellChecker;
+    QFutureWatcher<Hunspell*> _spellLoader;
+    bool _spellLoadStarted;
     bool _spellReady;
     QStringList _spellAddWords;
 
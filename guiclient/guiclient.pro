@@ -7,7 +7,7 @@ QT += xml sql script scripttools network
 QT += webkit xmlpatterns printsupport webkitwidgets
 
 isEqual(QT_MAJOR_VERSION, 5) {
-  QT     += help designer uitools quick websockets webchannel serialport
+  QT     += help designer uitools quick websockets webchannel serialport concurrent
 } else {
   CONFIG += help designer uitools
 }
@@ -711,6 +711,7 @@ HEADERS = ../common/format.h                    \
           cashReceiptItem.h             \
           cashReceiptMiscDistrib.h      \
           cashReceiptsEditList.h        \
+          changebus.h                   \
           changePoitemQty.h             \
           changeWoQty.h                 \
           characteristic.h              \
@@ -1335,6 +1336,7 @@ SOURCES = absoluteCalendarItem.cpp              \
           cashReceiptItem.cpp                   \
           cashReceiptMiscDistrib.cpp            \
           cashReceiptsEditList.cpp              \
+          changebus.cpp                         \
           changePoitemQty.cpp                   \
           changeWoQty.cpp                       \
           characteristic.cpp                    \
@@ -28,6 +28,7 @@ incidentWorkbench::incidentWorkbench(QWidget* parent, const char*, Qt::WindowFla
   setSearchVisible(true);
   setQueryOnStartEnabled(true);
   setAutoUpdateEnabled(true);
+  setKeyColumn("incdt_number");
 
   QString qryStatus = QString("SELECT status_seq, "
                               " CASE WHEN status_code = 'N' THEN '%1' "
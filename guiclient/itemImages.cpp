@@ -12,7 +12,8 @@
 
 #include <QVariant>
 #include <QImage>
-#include <quuencode.h>
+
+#include "imagecache.h"
 
 itemImages::itemImages(QWidget* parent, const char* name, Qt::WindowFlags fl)
   : XWidget(parent, name, fl)
@@ -68,7 +69,7 @@ void itemImages::sNext()
 
 void itemImages::sFillList()
 {
-  _images.prepare( "SELECT imageass_id, image_data, image_descrip,"
+  _images.prepare( "SELECT imageass_id, image_id, md5(image_data) AS image_hash, image_descrip,"
                    "       CASE WHEN (imageass_purpose='I') THEN :inventoryDescription"
                    "            WHEN (imageass_purpose='P') THEN :productDescription"
                    "            WHEN (imageass_purpose='E') THEN :engineeringReference"
@@ -104,8 +105,8 @@ void itemImages::loadImage()
 
   _description->setText(_images.value("purpose").toString() + " - " + _images.value("image_descrip").toString());
 
-  QImage image;
-  image.loadFromData(QUUDecode(_images.value("image_data").toString()));
-  _image->setPixmap(QPixmap::fromImage(image));
+  _image->setPixmap(QPixmap::fromImage(
+                      ImageCache::cache()->image(_images.value("image_id").toInt(),
+                                                 _images.value("image_hash").toString())));
 }
 
@@ -23,6 +23,7 @@
 #include "invoice.h"
 #include "mqlutil.h"
 #include "storedProcErrorLookup.h"
+#include "changebus.h"
 #include "errorReporter.h"
 
 listRecurringInvoices::listRecurringInvoices(QWidget* parent, const char* name, Qt::WindowFlags fl)
@@ -57,7 +58,7 @@ listRecurringInvoices::listRecurringInvoices(QWidget* parent, const char* name,
   if (_privileges->check("MaintainMiscInvoices") || _privileges->check("ViewMiscInvoices"))
     connect(_invchead, SIGNAL(valid(bool)), _view, SLOT(setEnabled(bool)));
 
-  connect(omfgThis, SIGNAL(invoicesUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("invoice", this, SLOT(sFillList()));
 
   sFillList();
 }
@@ -148,7 +148,6 @@ extern void xTupleMessageOutput(QtMsgType type, const char *msg);
 
 int main(int argc, char *argv[])
 {
-  XSqlQuery main;
   Q_INIT_RESOURCE(guiclient);
 
   QString username;
@@ -292,8 +291,15 @@ int main(int argc, char *argv[])
     }
   }
 
-  _splash->showMessage(QObject::tr("Loading Database Metrics"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  /* Each startup step needs what the ones before it loaded:
+       Metrics      <- edition, license check, version check, encryption key
+       Preferences  <- translations, GUIClient, password reset prompt
+       Privileges   <- GUIClient menus, password reset prompt
+       GUIClient    <- base currency and other configuration checks
+     Queries with no dependency on each other share a round trip below, so
+     each startupStage() costs as few trips to the server as possible.
+   */
+  startupStage(QObject::tr("Loading Database Metrics"));
   _metrics = new Metrics();
 
   // TODO: we should compose the splash screen on the fly from parts
@@ -319,31 +325,29 @@ int main(int argc, char *argv[])
 
   _Name = _Name.arg(edition);
 
-  _splash->showMessage(QObject::tr("Checking License Key"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(QObject::tr("Checking License Key"));
 
   int cnt = 50000;
   int tot = 50000;
 
+  bool xtweb = false;
   XSqlQuery metric;
   metric.prepare("SELECT numOfDatabaseUsers(:appName) AS xt_client_count,"
-                 "       numOfServerUsers() as total_client_count;");
+                 "       numOfServerUsers() as total_client_count,"
+                 "       packageIsEnabled('drupaluserinfo') AS xtweb;");
   metric.bindValue(":appName", _ConnAppName);
   metric.exec();
   if(metric.first())
   {
     cnt = metric.value("xt_client_count").toInt();
     tot = metric.value("total_client_count").toInt();
+    xtweb = metric.value("xtweb").toBool();
   }
   else
   {
     ErrorReporter::error(QtCriticalMsg, 0, QObject::tr("Error Counting Users"),
                          metric, __FILE__, __LINE__);
   }
-  metric.exec("SELECT packageIsEnabled('drupaluserinfo') AS result;");
-  bool xtweb = false;
-  if(metric.first())
-    xtweb = metric.value("result").toBool();
   bool forceLimit = _metrics->boolean("ForceLicenseLimit");
   bool forced = false;
   bool checkPass = true;
@@ -527,20 +531,21 @@ int main(int argc, char *argv[])
     }
   }
 
-  _splash->showMessage(QObject::tr("Loading User Preferences"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(QObject::tr("Loading User Preferences"));
   _preferences = new Preferences(username);
 
-  _splash->showMessage(QObject::tr("Loading User Privileges"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(QObject::tr("Loading User Privileges"));
   _privileges = new Privileges();
 
   // Load the translator and set the locale from the User's preferences
-  _splash->showMessage(QObject::tr("Loading Translation Dictionary"), SplashTextAlignment, SplashTextColor);
-  qApp->processEvents();
+  startupStage(QObject::tr("Loading Translation Dictionary"));
   XSqlQuery langq("SELECT locale_lang_file,"
                   "       lang_abbr2, lang_qt_number,"
-                  "       country_abbr, country_qt_number"
+                  "       country_abbr, country_qt_number,"
+                  "       ARRAY_TO_STRING(ARRAY(SELECT pkghead_name"
+                  "                               FROM pkghead"
+                  "                              WHERE packageIsEnabled(pkghead_name)),"
+                  "                       ',') AS pkgs"
                   "  FROM usr"
                   "  JOIN locale ON (usr_locale_id=locale_id)"
                   "  LEFT OUTER JOIN lang ON (locale_lang_id=lang_id)"
@@ -571,11 +576,7 @@ int main(int argc, char *argv[])
       files << "openrpt";
       files << "reports";
 
-      XSqlQuery pkglist("SELECT pkghead_name"
-                        "  FROM pkghead"
-                        " WHERE packageIsEnabled(pkghead_name);");
-      while(pkglist.next())
-        files << pkglist.value("pkghead_name").toString();
+      files << langq.value("pkgs").toString().split(",", QString::SkipEmptyParts);
     }
 
     if (files.size() > 0)
@@ -690,8 +691,7 @@ int main(int argc, char *argv[])
   omfgThis->_key = key;
 
   if (key.length() > 0) {
-	_splash->showMessage(QObject::tr("Loading Database Encryption Metrics"), SplashTextAlignment, SplashTextColor);
-	qApp->processEvents();
+	startupStage(QObject::tr("Loading Database Encryption Metrics"));
 	_metricsenc = new Metricsenc(key);
   }
 
@@ -758,53 +758,63 @@ int main(int argc, char *argv[])
   }
 
   // Check for the existance of a base currency, if none, one needs to
-  // be selected or created
-  XSqlQuery baseCurrency;
-  baseCurrency.prepare("SELECT COUNT(*) AS count FROM curr_symbol WHERE curr_base=TRUE;");
-  baseCurrency.exec();
-  if(baseCurrency.first())
+  // be selected or created. The other configuration checks don't depend on
+  // each other so they come back in the same round trip.
+  startupStage(QObject::tr("Checking Configuration"));
+  XSqlQuery configCheck("SELECT (SELECT COUNT(*) FROM curr_symbol"
+                        "         WHERE curr_base=TRUE) AS basecount,"
+                        "       (SELECT COUNT(*) FROM curr_symbol) AS currcount,"
+                        "       COALESCE((SELECT TRUE"
+                        "                   FROM accnt, metric"
+                        "                  WHERE ((CAST(accnt_id AS text)=metric_value)"
+                        "                    AND  (metric_name='CurrencyGainLossAccount'))), FALSE)"
+                        "   AND COALESCE((SELECT TRUE"
+                        "                   FROM accnt, metric"
+                        "                  WHERE ((CAST(accnt_id AS text)=metric_value)"
+                        "                    AND  (metric_name='GLSeriesDiscrepancyAccount'))), FALSE) AS gainloss,"
+                        "       EXISTS(SELECT 1 FROM period"
+                        "               WHERE ((current_date BETWEEN period_start AND period_end)"
+                        "                 AND (NOT period_closed))) AS periodfound,"
+                        "       EXISTS(SELECT curr_abbr"
+                        "                FROM curr_symbol s JOIN curr_rate r ON s.curr_id = r.curr_id"
+                        "               GROUP BY curr_abbr"
+                        "              HAVING NOT BOOL_OR(current_date BETWEEN curr_effective AND curr_expires)) AS xratemissing;");
+  if(! configCheck.first())
+  {
+    ErrorReporter::error(QtCriticalMsg, omfgThis, QObject::tr("Error Retrieving Base Currency Information"),
+                         configCheck, __FILE__, __LINE__);
+    // need to figure out appropriate return code for this...unusual error
+    return -1;
+  }
+
+  bool singleCurrency = configCheck.value("currcount").toInt() <= 1;
+  if(configCheck.value("basecount").toInt() != 1)
   {
-    if(baseCurrency.value("count").toInt() != 1)
+    XSqlQuery baseCurrency;
+    baseCurrency.prepare("SELECT COUNT(*) AS count FROM curr_symbol WHERE curr_base=TRUE;");
+    currenciesDialog newdlg(0, "", true);
+    newdlg.exec();
+    baseCurrency.exec();
+    if(baseCurrency.first())
     {
-      currenciesDialog newdlg(0, "", true);
-      newdlg.exec();
-      baseCurrency.exec();
-      if(baseCurrency.first())
-      {
-        if(baseCurrency.value("count").toInt() != 1)
-          return -1;
-      }
-      else
-      {
-        ErrorReporter::error(QtCriticalMsg, omfgThis, QObject::tr("Error Retrieving Base Currency Information"),
-                             baseCurrency, __FILE__, __LINE__);
-        // need to figure out appropriate return code for this...unusual error
+      if(baseCurrency.value("count").toInt() != 1)
         return -1;
-      }
     }
-  }
-  else
-  {
+    else
+    {
       ErrorReporter::error(QtCriticalMsg, omfgThis, QObject::tr("Error Retrieving Base Currency Information"),
                            baseCurrency, __FILE__, __LINE__);
-    // need to figure out appropriate return code for this...unusual error
-    return -1;
+      // need to figure out appropriate return code for this...unusual error
+      return -1;
+    }
+    singleCurrency = omfgThis->singleCurrency();
   }
 
-  if(!omfgThis->singleCurrency() &&
+  if(!singleCurrency &&
      _metrics->value("GLCompanySize").toInt() == 0)
   {
     // Check for the gain/loss and discrep accounts
-    main.prepare("SELECT COALESCE((SELECT TRUE"
-              "                   FROM accnt, metric"
-              "                  WHERE ((CAST(accnt_id AS text)=metric_value)"
-              "                    AND  (metric_name='CurrencyGainLossAccount'))), FALSE)"
-              "   AND COALESCE((SELECT TRUE"
-              "                   FROM accnt, metric"
-              "                  WHERE ((CAST(accnt_id AS text)=metric_value)"
-              "                    AND  (metric_name='GLSeriesDiscrepancyAccount'))), FALSE) AS result; ");
-    main.exec();
-    if(main.first() && main.value("result").toBool() != true)
+    if(configCheck.value("gainloss").toBool() != true)
       QMessageBox::warning( omfgThis, QObject::tr("Additional Configuration Required"),
         QObject::tr("<p>Your system is configured to use multiple Currencies, "
                     "but the Currency Gain/Loss Account and/or the G/L Series "
@@ -815,23 +825,14 @@ int main(int argc, char *argv[])
   }
 
 //  Check for valid current Fiscal period
-  XSqlQuery periodCheck;
-  periodCheck.prepare("SELECT EXISTS(SELECT 1 FROM period "
-            "     WHERE ((current_date BETWEEN period_start AND period_end) "
-            "       AND (NOT period_closed))) AS found; ");
-  periodCheck.exec();
-  if(periodCheck.first() && ! periodCheck.value("found").toBool())
+  if(! configCheck.value("periodfound").toBool())
   {
     createFiscalYear newdlg(NULL);
     (void)newdlg.exec();
   }
 
 //  Check for valid current exchange rates
-  XSqlQuery xrateCheck("SELECT curr_abbr"
-	          "  FROM curr_symbol s JOIN curr_rate r ON s.curr_id = r.curr_id"
-	          "  GROUP BY curr_abbr"
-	          "  HAVING NOT BOOL_OR(current_date BETWEEN curr_effective AND curr_expires);");
-  if (xrateCheck.first())
+  if (configCheck.value("xratemissing").toBool())
     QMessageBox::warning( omfgThis, QObject::tr("Additional Configuration Required"),
       QObject::tr("<p>Your system has alternate currencies without exchange rates "
                   "entered for the current date. "
@@ -864,6 +865,7 @@ int main(int argc, char *argv[])
     }
   }
 
+  startupStage(QString());
   app.exec();
 
 //  Clean up
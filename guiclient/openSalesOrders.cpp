@@ -18,6 +18,7 @@
 #include "copySalesOrder.h"
 #include "dspSalesOrderStatus.h"
 #include "dspShipmentsBySalesOrder.h"
+#include "changebus.h"
 #include "errorReporter.h"
 #include "issueToShipping.h"
 #include "printPackingList.h"
@@ -37,6 +38,7 @@ openSalesOrders::openSalesOrders(QWidget* parent, const char*, Qt::WindowFlags f
   setNewVisible(true);
   setQueryOnStartEnabled(true);
   setAutoUpdateEnabled(true);
+  setKeyColumn("cohead_number");
   setSearchVisible(true);
 
   _custid = -1;
@@ -99,7 +101,7 @@ openSalesOrders::openSalesOrders(QWidget* parent, const char*, Qt::WindowFlags f
     connect(list(), SIGNAL(itemSelected(int)), this, SLOT(sView()));
   }
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("salesorder", this, SLOT(sFillList()));
   connect(_showClosed, SIGNAL(toggled(bool)), this, SLOT(sFillList()));
 }
 
@@ -18,6 +18,7 @@
 
 #include <openreports.h>
 
+#include "changebus.h"
 #include "errorReporter.h"
 #include "storedProcErrorLookup.h"
 #include "todoItem.h"
@@ -80,8 +81,8 @@ opportunity::opportunity(QWidget* parent, const char* name, bool modal, Qt::Wind
   connect(_printSale, SIGNAL(clicked()), this, SLOT(sPrintSale()));
   connect(_salesList, SIGNAL(populateMenu(QMenu*,QTreeWidgetItem*)), this, SLOT(sPopulateSalesMenu(QMenu*)));
   connect(_salesList, SIGNAL(valid(bool)), this, SLOT(sHandleSalesPrivs()));
-  connect(omfgThis,	SIGNAL(quotesUpdated(int, bool)), this, SLOT(sFillSalesList()));
-  connect(omfgThis,	SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillSalesList()));
+  omfgThis->changes()->subscribe(QStringList() << "quote" << "salesorder",
+                                 this, SLOT(sFillSalesList()));
   connect(_assignedTo, SIGNAL(newId(int)), this, SLOT(sHandleAssigned()));
 
   _probability->setValidator(new QIntValidator(this));
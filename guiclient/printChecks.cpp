@@ -11,6 +11,7 @@
 #include "printChecks.h"
 
 #include <QFileDialog>
+#include <QHash>
 #include <QList>
 #include <QMessageBox>
 #include <QPrintDialog>
@@ -139,8 +140,6 @@ void printChecks::sPrint()
   ParameterList params;
   params.append("bankaccnt_id", _bankaccnt->id());
 
-  bool setup = true;
-
   QList<ORODocument*> singleCheckPrerendered;
   XSqlQuery checks;
   MetaSQLQuery mql = mqlLoad("checks", "detail");
@@ -151,22 +150,23 @@ void printChecks::sPrint()
     params.append("orderByName");
   
   checks = mql.toQuery(params);
-  QDomDocument docReport;
+
+  // every check in a run normally uses the same form, so fetch and parse
+  // each report definition once instead of once per check
+  QHash<QString, QDomDocument> reportDefs;
 
   while (checks.next())
   {
-    if (setup)
+    QString reportName = checks.value("report_name").toString();
+    if (! reportDefs.contains(reportName))
     {
-      // get the report definition out of the database
-      // this should somehow be condensed into a common code call or something
-      // in the near future to facilitate easier conversion in other places
-      // of the application to use the new rendering engine directly
+      QDomDocument docReport;
       XSqlQuery report;
       report.prepare( "SELECT report_source "
                       "  FROM report "
                       " WHERE (report_name=:report_name) "
                       "ORDER BY report_grade DESC LIMIT 1;" );
-      report.bindValue(":report_name", checks.value("report_name").toString());
+      report.bindValue(":report_name", reportName);
       report.exec();
       if (report.first())
       {
@@ -188,32 +188,32 @@ void printChecks::sPrint()
                              report, __FILE__, __LINE__);
         return;
       }
-      // end getting the report definition out the database
+      reportDefs.insert(reportName, docReport);
+    }
 
-      if(_setCheckNumber != -1 && _setCheckNumber != _nextCheckNum->text().toInt() && firstRun)
+    if(_setCheckNumber != -1 && _setCheckNumber != _nextCheckNum->text().toInt() && firstRun)
+    {
+      printPrint.prepare("SELECT setNextCheckNumber(:bankaccnt_id, :nextCheckNumber) AS result;");
+      printPrint.bindValue(":bankaccnt_id", _bankaccnt->id());
+      printPrint.bindValue(":nextCheckNumber", _nextCheckNum->text().toInt());
+      printPrint.exec();
+      if (printPrint.first())
       {
-        printPrint.prepare("SELECT setNextCheckNumber(:bankaccnt_id, :nextCheckNumber) AS result;");
-        printPrint.bindValue(":bankaccnt_id", _bankaccnt->id());
-        printPrint.bindValue(":nextCheckNumber", _nextCheckNum->text().toInt());
-        printPrint.exec();
-        if (printPrint.first())
-        {
-          int result = printPrint.value("result").toInt();
-          if (result < 0)
-          {
-            ErrorReporter::error(QtCriticalMsg, this, tr("Error Setting Next Check Number"),
-                                   storedProcErrorLookup("setNextCheckNumber", result),
-                                   __FILE__, __LINE__);
-            return;
-          }
-        }
-        else if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Printing Check"),
-                                      printPrint, __FILE__, __LINE__))
+        int result = printPrint.value("result").toInt();
+        if (result < 0)
         {
+          ErrorReporter::error(QtCriticalMsg, this, tr("Error Setting Next Check Number"),
+                                 storedProcErrorLookup("setNextCheckNumber", result),
+                                 __FILE__, __LINE__);
           return;
         }
-       firstRun = false;
       }
+      else if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Printing Check"),
+                                    printPrint, __FILE__, __LINE__))
+      {
+        return;
+      }
+     firstRun = false;
     }
 
     printPrint.prepare("UPDATE checkhead SET checkhead_number=fetchNextCheckNumber(checkhead_bankaccnt_id)"
@@ -230,7 +230,7 @@ void printChecks::sPrint()
     params.append("checkhead_id", checks.value("checkhead_id").toInt());
 
     ORPreRender pre;
-    pre.setDom(docReport);
+    pre.setDom(reportDefs.value(reportName));
     pre.setParamList(params);
     ORODocument * doc = pre.generate();
 
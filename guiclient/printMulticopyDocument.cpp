@@ -10,6 +10,7 @@
 
 #include "printMulticopyDocument.h"
 
+#include <QHash>
 #include <QMessageBox>
 #include <QSqlError>
 #include <QSqlRecord>
@@ -44,6 +45,7 @@ class printMulticopyDocumentPrivate : public Ui::printMulticopyDocument
 
     ~printMulticopyDocumentPrivate()
     {
+      clearReports();
       if (_printer)
       {
         delete _printer;
@@ -62,6 +64,29 @@ class printMulticopyDocumentPrivate : public Ui::printMulticopyDocument
     bool                      _mpIsInitialized;
     QList<QVariant>           _printed;
     QString                   _reportKey;
+    QHash<QString, orReport*> _reports;
+
+    // load each form once per print run rather than once per document
+    orReport *report(const QString &reportname)
+    {
+      if (! _reports.contains(reportname))
+      {
+        orReport *report = new orReport(reportname);
+        if (! report->isValid())
+        {
+          delete report;
+          report = 0;
+        }
+        _reports.insert(reportname, report);
+      }
+      return _reports.value(reportname);
+    }
+
+    void clearReports()
+    {
+      qDeleteAll(_reports);
+      _reports.clear();
+    }
 };
 
 printMulticopyDocument::printMulticopyDocument(QWidget    *parent,
@@ -356,6 +381,7 @@ void printMulticopyDocument::sPrint()
   }
 
   _data->_printed.clear();
+  _data->clearReports();
   emit finishedWithAll();
 
   if (_data->_captive)
@@ -387,8 +413,8 @@ bool printMulticopyDocument::sPrintOneDoc(XSqlQuery *docq)
     }
   }
 
-  orReport report(reportname);
-  if (! report.isValid())
+  orReport *report = _data->report(reportname);
+  if (! report)
     QMessageBox::critical(this, tr("Cannot Find Form"),
                           tr("<p>Cannot find form '%1' for %2 %3. "
                              "It cannot be printed until the Form "
@@ -399,8 +425,8 @@ bool printMulticopyDocument::sPrintOneDoc(XSqlQuery *docq)
   {
     for (int i = 0; i < _data->_copies->numCopies(); i++)
     {
-      report.setParamList(getParamsOneCopy(i, docq));
-      if (! report.isValid())
+      report->setParamList(getParamsOneCopy(i, docq));
+      if (! report->isValid())
       {
         ErrorReporter::error(QtCriticalMsg, this, tr("Invalid Parameters"),
                              tr("<p>Report '%1' cannot be run. Parameters "
@@ -409,14 +435,14 @@ bool printMulticopyDocument::sPrintOneDoc(XSqlQuery *docq)
         printedOk = false;
         continue;
       }
-      else if (report.print(_data->_printer, ! _data->_mpIsInitialized))
+      else if (report->print(_data->_printer, ! _data->_mpIsInitialized))
       {
         _data->_mpIsInitialized = true;
         printedOk = true;
       }
       else
       {
-        report.reportError(this);
+        report->reportError(this);
         printedOk = false;
         continue;
       }
@@ -19,6 +19,7 @@
 #include <comment.h>
 #include <metasql.h>
 
+#include "changebus.h"
 #include "mqlutil.h"
 #include "errorReporter.h"
 #include "guiErrorCheck.h"
@@ -98,8 +99,8 @@ project::project(QWidget* parent, const char* name, bool modal, Qt::WindowFlags
   connect(_showWo, SIGNAL(toggled(bool)), this, SLOT(sFillTaskList()));
   connect(_showIn, SIGNAL(toggled(bool)), this, SLOT(sFillTaskList()));
 
-  connect(omfgThis, SIGNAL(salesOrdersUpdated(int, bool)), this, SLOT(sFillTaskList()));
-  connect(omfgThis, SIGNAL(quotesUpdated(int, bool)), this, SLOT(sFillTaskList()));
+  omfgThis->changes()->subscribe(QStringList() << "salesorder" << "quote",
+                                 this, SLOT(sFillTaskList()));
   connect(omfgThis, SIGNAL(workOrdersUpdated(int, bool)), this, SLOT(sFillTaskList()));
   connect(omfgThis, SIGNAL(purchaseOrdersUpdated(int, bool)), this, SLOT(sFillTaskList()));
 
@@ -19,6 +19,7 @@
 
 #include <openreports.h>
 
+#include "changebus.h"
 #include "crmaccount.h"
 #include "errorReporter.h"
 #include "guiErrorCheck.h"
@@ -40,7 +41,7 @@ prospect::prospect(QWidget* parent, const char* name, Qt::WindowFlags fl)
   connect(_quotes,	SIGNAL(populateMenu(QMenu*,QTreeWidgetItem*)),	this,	SLOT(sPopulateQuotesMenu(QMenu*)));
   connect(_save,	SIGNAL(clicked()),	this,	SLOT(sSave()));
   connect(_viewQuote,	SIGNAL(clicked()),	this,	SLOT(sViewQuote()));
-  connect(omfgThis,	SIGNAL(quotesUpdated(int, bool)), this, SLOT(sFillQuotesList()));
+  omfgThis->changes()->subscribe("quote", this, SLOT(sFillQuotesList()));
 
   if (_privileges->check("MaintainQuotes"))
     connect(_quotes, SIGNAL(itemSelected(int)), _editQuote, SLOT(animateClick()));
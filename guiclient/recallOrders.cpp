@@ -18,6 +18,7 @@
 #include <parameter.h>
 #include "mqlutil.h"
 #include "storedProcErrorLookup.h"
+#include "changebus.h"
 #include "errorReporter.h"
 
 recallOrders::recallOrders(QWidget* parent, const char* name, Qt::WindowFlags fl)
@@ -27,7 +28,7 @@ recallOrders::recallOrders(QWidget* parent, const char* name, Qt::WindowFlags fl
 
   connect(_query,      SIGNAL(clicked()),                  this, SLOT(sFillList()));
   connect(_recall,	   SIGNAL(clicked()),	                 this, SLOT(sRecall()));
-  connect(omfgThis,    SIGNAL(invoicesUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("invoice", this, SLOT(sFillList()));
 
   _showInvoiced->setEnabled(_privileges->check("RecallInvoicedShipment"));
   
@@ -14,12 +14,15 @@
 #include <QCursor>
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QMenu>
+#include <QSet>
 #include <QSqlError>
 #include <QVariant>
 
 #include <metasql.h>
 #include <parameter.h>
 
+#include "changebus.h"
 #include "mqlutil.h"
 #include "bankAdjustment.h"
 #include "importData.h"
@@ -46,6 +49,11 @@ reconcileBankaccount::reconcileBankaccount(QWidget* parent, const char* name, Qt
     connect(_startDate, SIGNAL(newDate(QDate)), this, SLOT(sDateChanged()));
     connect(_endDate,   SIGNAL(newDate(QDate)), this, SLOT(sDateChanged()));
 
+    _receipts->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    _checks->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    connect(_receipts, SIGNAL(populateMenu(QMenu*, QTreeWidgetItem*)), this, SLOT(sPopulateReceiptsMenu(QMenu*, QTreeWidgetItem*)));
+    connect(_checks,   SIGNAL(populateMenu(QMenu*, QTreeWidgetItem*)), this, SLOT(sPopulateChecksMenu(QMenu*, QTreeWidgetItem*)));
+
     _receipts->addColumn(tr("Cleared"),       _ynColumn * 2, Qt::AlignCenter, true, "cleared");
     _receipts->addColumn(tr("Date"),            _dateColumn, Qt::AlignCenter, true, "transdate");
     _receipts->addColumn(tr("Doc. Type"),     _ynColumn * 2, Qt::AlignCenter, true, "doc_type");
@@ -93,7 +101,7 @@ reconcileBankaccount::reconcileBankaccount(QWidget* parent, const char* name, Qt
   
     connect(omfgThis, SIGNAL(bankAdjustmentsUpdated(int, bool)), this, SLOT(populate()));
     connect(omfgThis, SIGNAL(checksUpdated(int, int, bool)), this, SLOT(populate()));
-    connect(omfgThis, SIGNAL(cashReceiptsUpdated(int, bool)), this, SLOT(populate()));
+    omfgThis->changes()->subscribe("cashreceipt", this, SLOT(populate()));
     connect(omfgThis, SIGNAL(glSeriesUpdated()), this, SLOT(populate()));
 }
 
@@ -500,199 +508,146 @@ void reconcileBankaccount::sAddAdjustment()
   omfgThis->handleNewWindow(newdlg, Qt::ApplicationModal);
 }
 
-void reconcileBankaccount::sReceiptsToggleCleared()
+void reconcileBankaccount::sPopulateReceiptsMenu(QMenu *pMenu, QTreeWidgetItem *)
+{
+  pMenu->addAction(tr("Toggle Cleared"), this, SLOT(sReceiptsToggleCleared()));
+}
+
+void reconcileBankaccount::sPopulateChecksMenu(QMenu *pMenu, QTreeWidgetItem *)
 {
-  XSqlQuery reconcileReceiptsToggleCleared;
-  XTreeWidgetItem *item = (XTreeWidgetItem*)_receipts->currentItem();
-  XTreeWidgetItem *child = 0;
-  bool setto = true;
+  pMenu->addAction(tr("Toggle Cleared"), this, SLOT(sChecksToggleCleared()));
+}
 
-  if(0 == item)
+void reconcileBankaccount::sReceiptsToggleCleared()
+{
+  QList<XTreeWidgetItem*> selected = _receipts->selectedItems();
+  if (selected.isEmpty() && _receipts->currentItem())
+    selected.append((XTreeWidgetItem*)_receipts->currentItem());
+  if (selected.isEmpty())
     return;
 
-  _receipts->scrollToItem(item);
+  if (_receipts->currentItem())
+    _receipts->scrollToItem(_receipts->currentItem());
 
-  if(item->altId() == 9)
+  // a journal toggles every child that isn't already in its new state
+  QList<XTreeWidgetItem*> items;
+  QSet<XTreeWidgetItem*>  seen;
+  foreach (XTreeWidgetItem *item, selected)
   {
-    setto = item->text(0) == tr("No");
-    for (int i = 0; i < item->childCount(); i++)
+    if (item->altId() == 9)
     {
-      child = item->child(i);
-      if(child->text(0) != (setto ? tr("Yes") : tr("No")))
+      bool setto = item->text(0) == tr("No");
+      for (int i = 0; i < item->childCount(); i++)
       {
-        double rate = QLocale().toDouble(child->text(6));
-        double amount = QLocale().toDouble(child->text(7));
-
-        if (_allowEdit->isChecked() && child->text(0) != tr("Yes"))
+        XTreeWidgetItem *child = item->child(i);
+        if (child->text(0) != (setto ? tr("Yes") : tr("No")) && ! seen.contains(child))
         {
-          ParameterList params;
-          params.append("transtype", "receipt");
-          params.append("bankaccntid", _bankaccnt->id());
-          params.append("bankrecid", _bankrecid);
-          params.append("sourceid", child->id());
-          if(child->altId()==1)
-            params.append("source", "GL");
-          else if(child->altId()==2)
-            params.append("source", "SL");
-          else if(child->altId()==3)
-            params.append("source", "AD");
-          toggleBankrecCleared newdlg(this, "", true);
-          newdlg.set(params);
-          newdlg.exec();
-        }
-        else
-        {
-          reconcileReceiptsToggleCleared.prepare("SELECT toggleBankrecCleared(:bankrecid, :source, :sourceid, :currrate, :baseamount) AS cleared");
-          reconcileReceiptsToggleCleared.bindValue(":bankrecid", _bankrecid);
-          reconcileReceiptsToggleCleared.bindValue(":sourceid", child->id());
-          if(child->altId()==1)
-            reconcileReceiptsToggleCleared.bindValue(":source", "GL");
-          else if(child->altId()==2)
-            reconcileReceiptsToggleCleared.bindValue(":source", "SL");
-          else if(child->altId()==3)
-            reconcileReceiptsToggleCleared.bindValue(":source", "AD");
-          reconcileReceiptsToggleCleared.bindValue(":currrate", rate);
-          reconcileReceiptsToggleCleared.bindValue(":baseamount", amount);
-          reconcileReceiptsToggleCleared.exec();
-          if(reconcileReceiptsToggleCleared.first())
-            child->setText(0, (reconcileReceiptsToggleCleared.value("cleared").toBool() ? tr("Yes") : tr("No") ));
-          else if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Bank Reconciliation Information"),
-                                        reconcileReceiptsToggleCleared, __FILE__, __LINE__))
-          {
-            return;
-          }
+          seen.insert(child);
+          items.append(child);
         }
       }
     }
-    item->setText(0, (setto ? tr("Yes") : tr("No")));
-    populate();
-  }
-  else
-  {
-    double rate = QLocale().toDouble(item->text(6));
-    double amount = QLocale().toDouble(item->text(7));
-    
-    if (_allowEdit->isChecked() && item->text(0) != tr("Yes"))
-    {
-      ParameterList params;
-      params.append("transtype", "receipt");
-      params.append("bankaccntid", _bankaccnt->id());
-      params.append("bankrecid", _bankrecid);
-      params.append("sourceid", item->id());
-      if(item->altId()==1)
-        params.append("source", "GL");
-      else if(item->altId()==2)
-        params.append("source", "SL");
-      else if(item->altId()==3)
-        params.append("source", "AD");
-      toggleBankrecCleared newdlg(this, "", true);
-      newdlg.set(params);
-      newdlg.exec();
-      populate();
-    }
-    else
+    else if (! seen.contains(item))
     {
-      reconcileReceiptsToggleCleared.prepare("SELECT toggleBankrecCleared(:bankrecid, :source, :sourceid, :currrate, :baseamount) AS cleared");
-      reconcileReceiptsToggleCleared.bindValue(":bankrecid", _bankrecid);
-      reconcileReceiptsToggleCleared.bindValue(":sourceid", item->id());
-      if(item->altId()==1)
-        reconcileReceiptsToggleCleared.bindValue(":source", "GL");
-      else if(item->altId()==2)
-        reconcileReceiptsToggleCleared.bindValue(":source", "SL");
-      else if(item->altId()==3)
-        reconcileReceiptsToggleCleared.bindValue(":source", "AD");
-      reconcileReceiptsToggleCleared.bindValue(":currrate", rate);
-      reconcileReceiptsToggleCleared.bindValue(":baseamount", amount);
-      reconcileReceiptsToggleCleared.exec();
-      if(reconcileReceiptsToggleCleared.first())
-      {
-        item->setText(0, (reconcileReceiptsToggleCleared.value("cleared").toBool() ? tr("Yes") : tr("No") ));
-
-        item = (XTreeWidgetItem*)item->QTreeWidgetItem::parent();
-        if(item != 0 && item->altId() == 9)
-        {
-          setto = true;
-          for (int i = 0; i < item->childCount(); i++)
-          {
-            setto = (setto && (item->child(i)->text(0) == tr("Yes")));
-          }
-          item->setText(0, (setto ? tr("Yes") : tr("No")));
-          populate();
-        }
-      }
-      else
-      {
-        populate();
-        if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Bank Reconciliation Information"),
-                                      reconcileReceiptsToggleCleared, __FILE__, __LINE__))
-        {
-          return;
-        }
-      }
+      seen.insert(item);
+      items.append(item);
     }
   }
+
+  toggleCleared(items, "receipt");
+  populate();
 }
 
 void reconcileBankaccount::sChecksToggleCleared()
 {
-  XSqlQuery reconcileChecksToggleCleared;
-  XTreeWidgetItem *item = (XTreeWidgetItem*)_checks->currentItem();
-
-  if(0 == item)
+  QList<XTreeWidgetItem*> items = _checks->selectedItems();
+  if (items.isEmpty() && _checks->currentItem())
+    items.append((XTreeWidgetItem*)_checks->currentItem());
+  if (items.isEmpty())
     return;
 
-  _checks->scrollToItem(item);
+  if (_checks->currentItem())
+    _checks->scrollToItem(_checks->currentItem());
 
-  double rate = item->rawValue("doc_exchrate").toDouble();
-  double amount = item->rawValue("base_amount").toDouble();
-  
-  if (_allowEdit->isChecked() && item->text(0) != tr("Yes"))
-  {
-    ParameterList params;
-    params.append("transtype", "check");
-    params.append("bankaccntid", _bankaccnt->id());
-    params.append("bankrecid", _bankrecid);
-    params.append("sourceid", item->id());
-    if(item->altId()==1)
-      params.append("source", "GL");
-    else if(item->altId()==2)
-      params.append("source", "SL");
-    else if(item->altId()==3)
-      params.append("source", "AD");
-    toggleBankrecCleared newdlg(this, "", true);
-    newdlg.set(params);
-    newdlg.exec();
-    populate();
-  }
-  else
+  toggleCleared(items, "check");
+  populate();
+}
+
+/* Toggle the cleared flag of receipts or checks. Rows that need the
+   exchange rate/effective date edited get the toggleBankrecCleared dialog
+   one at a time; everything else goes to the server in a single statement
+   instead of one round trip per row.
+ */
+bool reconcileBankaccount::toggleCleared(const QList<XTreeWidgetItem*> &items, const QString &transtype)
+{
+  QStringList sources;
+  QStringList sourceids;
+  QStringList currrates;
+  QStringList baseamounts;
+  QHash<QString, XTreeWidgetItem*> toggled;
+
+  foreach (XTreeWidgetItem *item, items)
   {
-    reconcileChecksToggleCleared.prepare("SELECT toggleBankrecCleared(:bankrecid, :source, :sourceid, :currrate, :baseamount) AS cleared");
-    reconcileChecksToggleCleared.bindValue(":bankrecid", _bankrecid);
-    reconcileChecksToggleCleared.bindValue(":sourceid", item->id());
+    QString source;
     if(item->altId()==1)
-      reconcileChecksToggleCleared.bindValue(":source", "GL");
+      source = "GL";
     else if(item->altId()==2)
-      reconcileChecksToggleCleared.bindValue(":source", "SL");
+      source = "SL";
     else if(item->altId()==3)
-      reconcileChecksToggleCleared.bindValue(":source", "AD");
-    reconcileChecksToggleCleared.bindValue(":currrate", rate);
-    reconcileChecksToggleCleared.bindValue(":baseamount", amount);
-    reconcileChecksToggleCleared.exec();
-    if(reconcileChecksToggleCleared.first())
-    {
-      item->setText(0, (reconcileChecksToggleCleared.value("cleared").toBool() ? tr("Yes") : tr("No") ));
-      populate();
-    }
-    else
+      source = "AD";
+
+    if (_allowEdit->isChecked() && item->text(0) != tr("Yes"))
     {
-      populate();
-      if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Bank Reconciliation Information"),
-                                    reconcileChecksToggleCleared, __FILE__, __LINE__))
-      {
-        return;
-      }
+      ParameterList params;
+      params.append("transtype", transtype);
+      params.append("bankaccntid", _bankaccnt->id());
+      params.append("bankrecid", _bankrecid);
+      params.append("sourceid", item->id());
+      if (! source.isEmpty())
+        params.append("source", source);
+      toggleBankrecCleared newdlg(this, "", true);
+      newdlg.set(params);
+      newdlg.exec();
+      continue;
     }
+
+    sources     << (source.isEmpty() ? QString("NULL") : source);
+    sourceids   << QString::number(item->id());
+    currrates   << QString::number(item->rawValue("doc_exchrate").toDouble(), 'g', 15);
+    baseamounts << QString::number(item->rawValue("base_amount").toDouble(), 'g', 15);
+    toggled.insert(source + ":" + QString::number(item->id()), item);
+  }
+
+  if (toggled.isEmpty())
+    return true;
+
+  XSqlQuery toggleq;
+  toggleq.prepare("SELECT source, sourceid,"
+                  "       toggleBankrecCleared(:bankrecid, source, sourceid,"
+                  "                            currrate, baseamount) AS cleared"
+                  "  FROM (SELECT UNNEST(CAST(:sources     AS TEXT[]))    AS source,"
+                  "               UNNEST(CAST(:sourceids   AS INTEGER[])) AS sourceid,"
+                  "               UNNEST(CAST(:currrates   AS NUMERIC[])) AS currrate,"
+                  "               UNNEST(CAST(:baseamounts AS NUMERIC[])) AS baseamount"
+                  "       ) AS toggle;");
+  toggleq.bindValue(":bankrecid",   _bankrecid);
+  toggleq.bindValue(":sources",     QString("{%1}").arg(sources.join(",")));
+  toggleq.bindValue(":sourceids",   QString("{%1}").arg(sourceids.join(",")));
+  toggleq.bindValue(":currrates",   QString("{%1}").arg(currrates.join(",")));
+  toggleq.bindValue(":baseamounts", QString("{%1}").arg(baseamounts.join(",")));
+  toggleq.exec();
+  while (toggleq.next())
+  {
+    XTreeWidgetItem *item = toggled.value(toggleq.value("source").toString() + ":" +
+                                          toggleq.value("sourceid").toString());
+    if (item)
+      item->setText(0, toggleq.value("cleared").toBool() ? tr("Yes") : tr("No"));
   }
+  if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Retrieving Bank Reconciliation Information"),
+                           toggleq, __FILE__, __LINE__))
+    return false;
+
+  return true;
 }
 
 void reconcileBankaccount::sBankaccntChanged()
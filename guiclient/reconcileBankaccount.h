@@ -34,6 +34,8 @@ public slots:
     virtual void sCancel();
     virtual void sChecksToggleCleared();
     virtual void sImport();
+    virtual void sPopulateChecksMenu(QMenu *, QTreeWidgetItem *);
+    virtual void sPopulateReceiptsMenu(QMenu *, QTreeWidgetItem *);
     virtual void sReceiptsToggleCleared();
     virtual void sReconcile();
     virtual bool sSave(bool = true);
@@ -43,6 +45,8 @@ protected slots:
     virtual void languageChange();
 
 private:
+    bool toggleCleared(const QList<XTreeWidgetItem*> &, const QString &);
+
     int _bankrecid;
 	int _bankaccntid;
     bool _datesAreOK;
@@ -15,6 +15,7 @@
 #include <QScriptEngineDebugger>
 
 #include "include.h"
+#include "scriptenginepool.h"
 #include "scripttoolbox.h"
 #include "qeventproto.h"
 #include "parameterlistsetup.h"
@@ -41,8 +42,10 @@ ScriptablePrivate::~ScriptablePrivate()
 
 QScriptEngine *ScriptablePrivate::engine()
 {
+  bool created = ! _engine;
   QScriptEngine *engine = ScriptableWidget::engine();
-  omfgThis->loadScriptGlobals(engine);
+  if (created && ! ScriptEnginePool::pool()->hasGlobals(engine))
+    omfgThis->loadScriptGlobals(engine);
   QScriptValue mywidget = engine->globalObject().property("mywidget");
 
   // mywindow is required for backwards compatibility.
@@ -47,6 +47,7 @@
 #include "xuiloader.h"
 #include "getscreen.h"
 #include "errorReporter.h"
+#include "include.h"
 
 /** @ingroup scriptapi
 
@@ -1502,26 +1503,29 @@ QString scriptHandleIncludes(QString source)
           name = words.at(1);
 
         line.replace(i, "// " + line.at(i));
-        XSqlQuery inclq;
-        inclq.prepare("SELECT script_source "
-                      "FROM script "
-                      "WHERE ((script_name=:name)"
-                      "  AND  ((script_order=:order) OR (:order = -1))"
-                      "  AND  script_enabled) "
-                      "ORDER BY script_order;");
-        inclq.bindValue(":name",  name);
-        inclq.bindValue(":order", order);
-        inclq.exec();
-        bool found = false;
-        while (inclq.next())
+
+        IncludeCache *cache = IncludeCache::cache();
+        QString key = QString("#include %1 %2").arg(name).arg(order);
+        if (! cache->hasExpansion(key))
         {
-          found = true;
-          line.replace(i,
-                       line.at(i) + "\n" + scriptHandleIncludes(inclq.value("script_source").toString()));
+          if (! cache->enter(name))
+            continue;
+
+          QStringList expanded;
+          foreach (IncludedScript script, cache->scripts(name))
+          {
+            if (order == -1 || script.order == order)
+              expanded << scriptHandleIncludes(script.source);
+          }
+          cache->leave(name);
+          cache->setExpansion(key, expanded.isEmpty() ? QString()
+                                   : expanded.join("\n"));
         }
-        if (found)
-          line.replace(i,
-                       line.at(i) + "\n// end include of " + name);
+
+        QString expansion = cache->expansion(key);
+        if (! expansion.isNull())
+          line.replace(i, line.at(i) + "\n" + expansion +
+                          "\n// end include of " + name);
       }
     }
     returnVal = line.join("\n");
@@ -25,6 +25,7 @@
 #include "getGLDistDate.h"
 #include "printCreditMemo.h"
 #include "storedProcErrorLookup.h"
+#include "changebus.h"
 #include "errorReporter.h"
 
 unpostedCreditMemos::unpostedCreditMemos(QWidget* parent, const char* name, Qt::WindowFlags fl)
@@ -68,7 +69,7 @@ unpostedCreditMemos::unpostedCreditMemos(QWidget* parent, const char* name, Qt::
     if (_privileges->check("PostARDocuments"))
       connect(_cmhead, SIGNAL(valid(bool)), _post, SLOT(setEnabled(bool)));
 
-    connect(omfgThis, SIGNAL(creditMemosUpdated()), this, SLOT(sFillList()));
+    omfgThis->changes()->subscribe("creditmemo", this, SLOT(sFillList()));
 
     sFillList();
 }
@@ -26,6 +26,7 @@
 #include "printInvoice.h"
 #include "storedProcErrorLookup.h"
 #include "distributeInventory.h"
+#include "changebus.h"
 #include "errorReporter.h"
 
 unpostedInvoices::unpostedInvoices(QWidget* parent, const char* name, Qt::WindowFlags fl)
@@ -71,7 +72,7 @@ unpostedInvoices::unpostedInvoices(QWidget* parent, const char* name, Qt::Window
   if (_preferences->boolean("XCheckBox/forgetful"))
     _printJournal->setChecked(true);
 
-  connect(omfgThis, SIGNAL(invoicesUpdated(int, bool)), this, SLOT(sFillList()));
+  omfgThis->changes()->subscribe("invoice", this, SLOT(sFillList()));
 
   sFillList();
 }
@@ -27,7 +27,10 @@ xTupleGuiClientInterface::xTupleGuiClientInterface(QObject *pParent)
   : GuiClientInterface(pParent)
 {
   if (pParent)
+  {
     connect(pParent, SIGNAL(dbConnectionLost()), this, SIGNAL(dbConnectionLost()));
+    connect(pParent, SIGNAL(spellCheckerReady()), this, SIGNAL(spellCheckerReady()));
+  }
 }
 
 QWidget* xTupleGuiClientInterface::openWindow(const QString      pname,
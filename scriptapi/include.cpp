@@ -9,6 +9,11 @@
  */
 
 #include "include.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QSqlError>
+
 #include <xsqlquery.h>
 
 /*! \file include.cpp
@@ -19,6 +24,105 @@
   extend xTuple ERP.
 */
 
+/*! \brief Holds the script rows and expanded sources used by include().
+
+  Scripts are looked up by name once and reused until a pkghead, script,
+  or pkgscript notification says they may have changed or the connection
+  is lost. The cache also tracks which scripts are currently being
+  included so recursive includes can be stopped instead of running until
+  the stack overflows.
+ */
+IncludeCache *IncludeCache::cache()
+{
+  static IncludeCache *_cache = 0;
+  if (! _cache)
+    _cache = new IncludeCache(QCoreApplication::instance());
+  _cache->checkConnection();
+  return _cache;
+}
+
+IncludeCache::IncludeCache(QObject *parent)
+  : NotifyCache(QStringList() << "pkghead" << "script" << "pkgscript", parent)
+{
+}
+
+QList<IncludedScript> IncludeCache::scripts(const QString &name)
+{
+  if (_scriptsByName.contains(name))
+    return _scriptsByName.value(name);
+
+  QList<IncludedScript> result;
+  XSqlQuery scriptq;
+  scriptq.prepare("SELECT script_id, script_order, script_source AS src"
+                  "  FROM script"
+                  " WHERE ((script_name=:script_name)"
+                  "   AND  (script_enabled))"
+                  " ORDER BY script_order;");
+  scriptq.bindValue(":script_name", name);
+  scriptq.exec();
+  while (scriptq.next())
+  {
+    IncludedScript script;
+    script.id     = scriptq.value("script_id").toInt();
+    script.order  = scriptq.value("script_order").toInt();
+    script.source = scriptq.value("src").toString();
+    result.append(script);
+  }
+
+  if (scriptq.lastError().type() == QSqlError::NoError)
+    _scriptsByName.insert(name, result);
+  else
+    qWarning() << "could not look up script" << name
+               << scriptq.lastError().text();
+
+  return result;
+}
+
+bool IncludeCache::hasExpansion(const QString &key) const
+{
+  return _expansions.contains(key);
+}
+
+QString IncludeCache::expansion(const QString &key) const
+{
+  return _expansions.value(key);
+}
+
+void IncludeCache::setExpansion(const QString &key, const QString &source)
+{
+  _expansions.insert(key, source);
+}
+
+/*! \brief Mark the named script as being included.
+
+  \return false if the script is already being included further up the
+          include chain, meaning the caller has found a cycle.
+ */
+bool IncludeCache::enter(const QString &name)
+{
+  if (_including.contains(name))
+  {
+    qWarning() << "include cycle detected:"
+               << (_including.join(" -> ") + " -> " + name);
+    return false;
+  }
+  _including.append(name);
+  return true;
+}
+
+void IncludeCache::leave(const QString &name)
+{
+  int idx = _including.lastIndexOf(name);
+  if (idx >= 0)
+    _including.removeAt(idx);
+}
+
+void IncludeCache::clear()
+{
+  _scriptsByName.clear();
+  _expansions.clear();
+}
+
 /*! \brief Sets the include() function as a property of the global object.
 
   This installs the include() function as a property
@@ -53,12 +157,7 @@ void setupInclude(QScriptEngine *engine)
 QScriptValue includeScript(QScriptContext *context, QScriptEngine *engine)
 {
   int count = 0;
-  XSqlQuery scriptq;
-  scriptq.prepare("SELECT script_id, script_source AS src"
-                  "  FROM script"
-                  " WHERE ((script_name=:script_name)"
-                  "   AND  (script_enabled))"
-                  " ORDER BY script_order;");
+  IncludeCache *cache = IncludeCache::cache();
 
   context->setActivationObject(context->parentContext()->activationObject());
   context->setThisObject(context->parentContext()->thisObject());
@@ -66,23 +165,23 @@ QScriptValue includeScript(QScriptContext *context, QScriptEngine *engine)
   for (; count < context->argumentCount(); count++)
   {
     QString scriptname = context->argument(count).toString();
-    scriptq.bindValue(":script_name", scriptname);
-    scriptq.exec();
-    while (scriptq.next())
+    if (! cache->enter(scriptname))
+      continue;
+
+    foreach (IncludedScript script, cache->scripts(scriptname))
     {
-      QScriptValue result = engine->evaluate(scriptq.value("src").toString(),
-                                             scriptname,
-                                             1);
+      QScriptValue result = engine->evaluate(script.source, scriptname, 1);
       if (engine->hasUncaughtException())
       {
         qWarning() << "uncaught exception in" << scriptname
-                   << "(id" << scriptq.value("script_id").toInt()
+                   << "(id" << script.id
                    << ") at line"
                    << engine->uncaughtExceptionLineNumber() << ":"
                    << result.toString();
         break;
       }
     }
+    cache->leave(scriptname);
   }
 
   return engine->toScriptValue(count);
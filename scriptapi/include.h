@@ -11,10 +11,48 @@
 #ifndef __INCLUDE_H__
 #define __INCLUDE_H__
 
-#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QStringList>
 #include <QtScript>
 
+#include "notifycache.h"
+
 void setupInclude(QScriptEngine *engine);
 QScriptValue includeScript(QScriptContext *context, QScriptEngine *engine);
 
+struct IncludedScript
+{
+  int     id;
+  int     order;
+  QString source;
+};
+
+class IncludeCache : public NotifyCache
+{
+  Q_OBJECT
+
+  public:
+    static IncludeCache *cache();
+
+    QList<IncludedScript> scripts(const QString &name);
+
+    bool    hasExpansion(const QString &key) const;
+    QString expansion(const QString &key)    const;
+    void    setExpansion(const QString &key, const QString &source);
+
+    bool enter(const QString &name);
+    void leave(const QString &name);
+
+  public slots:
+    virtual void clear();
+
+  protected:
+    IncludeCache(QObject *parent = 0);
+
+    QHash<QString, QList<IncludedScript> > _scriptsByName;
+    QHash<QString, QString>                _expansions;
+    QStringList                            _including;
+};
+
 #endif
@@ -9,9 +9,7 @@
  */
 
 #include "qiconproto.h"
-#include "xsqlquery.h"
-
-#include <quuencode.h>
+#include "imagecache.h"
 
 #include <QIcon>
 #include <QImage>
@@ -59,18 +57,9 @@ void QIconProto::addDbImage(const QString& name)
   QIcon *item = qscriptvalue_cast<QIcon*>(thisObject());
   if (item)
   {
-    QImage img;
-    XSqlQuery image;
-    image.prepare( "SELECT image_data "
-                   "FROM image "
-                   "WHERE (image_name=:name);" );
-    image.bindValue(":name", name);
-    image.exec();
-    if (image.first())
-    {
-      img.loadFromData(QUUDecode(image.value("image_data").toString()));
-      item->addPixmap(QPixmap::fromImage(img));
-    }
+    QPixmap pixmap = ImageCache::cache()->pixmap(name);
+    if (! pixmap.isNull())
+      item->addPixmap(pixmap);
   }
 }
 
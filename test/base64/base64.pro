@@ -0,0 +1,25 @@
+#
+# This file is part of the xTuple ERP: PostBooks Edition, a free and
+# open source Enterprise Resource Planning software suite,
+# Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+# It is licensed to you under the Common Public Attribution License
+# version 1.0, the full text of which (including xTuple-specific Exhibits)
+# is available at www.xtuple.com/CPAL.  By using this software, you agree
+# to be bound by its terms.
+#
+
+TARGET   = checkBase64
+TEMPLATE = app
+CONFIG  += console testcase warn_on
+CONFIG  -= app_bundle
+
+INCLUDEPATH += ../../common
+
+OBJECTS_DIR = tmp
+MOC_DIR     = tmp
+
+SOURCES = checkBase64.cpp \
+          ../../common/qbase64encode.cpp
+HEADERS = ../../common/qbase64encode.h
+
+QT -= gui
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+/* Checks QBase64Encode and QBase64Decode against QByteArray::toBase64
+   and fromBase64 on random buffers, from a few bytes up to 100 MB.
+   QBase64Encode breaks lines every 76 characters and ends with a
+   newline, so newlines are removed before comparing.
+ */
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QList>
+#include <QTextStream>
+
+#include "qbase64encode.h"
+
+#define LINECHARS 76
+
+static QTextStream out(stdout);
+static int failures = 0;
+
+/* xorshift, so the same buffers come out on every platform and run */
+static quint32 _seed = 2463534242U;
+static QByteArray randomBytes(int size)
+{
+  QByteArray result(size, '\0');
+  char *p = result.data();
+  for (int i = 0; i < size; i++)
+  {
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    p[i] = (char)(_seed >> 24);
+  }
+  return result;
+}
+
+static void fail(int size, const QString &what)
+{
+  failures++;
+  out << "size " << size << ": " << what << "\n";
+  out.flush();
+}
+
+/* no line may be longer than LINECHARS and the text must end in a newline */
+static bool layoutOk(const QByteArray &encoded)
+{
+  if (! encoded.endsWith('\n'))
+    return false;
+  int start = 0;
+  int nl;
+  while ((nl = encoded.indexOf('\n', start)) >= 0)
+  {
+    if (nl - start > LINECHARS)
+      return false;
+    start = nl + 1;
+  }
+  return true;
+}
+
+static QByteArray withoutNewlines(const QByteArray &encoded)
+{
+  QByteArray result = encoded;
+  result.replace('\n', QByteArray());
+  return result;
+}
+
+static void checkStreams(const QByteArray &data)
+{
+  QByteArray expected = data.toBase64();
+
+  QByteArray plain(data);
+  QBuffer in(&plain);
+  in.open(QIODevice::ReadOnly);
+  QByteArray encoded;
+  QBuffer enc(&encoded);
+  enc.open(QIODevice::WriteOnly);
+  if (! QBase64Encode(in, enc))
+    fail(data.size(), "streaming encode reported an error");
+  enc.close();
+
+  if (! layoutOk(encoded))
+    fail(data.size(), "streaming encode line layout is wrong");
+  if (withoutNewlines(encoded) != expected)
+    fail(data.size(), "streaming encode differs from QByteArray::toBase64");
+  expected.clear();
+
+  enc.open(QIODevice::ReadOnly);
+  QByteArray decoded;
+  QBuffer dec(&decoded);
+  dec.open(QIODevice::WriteOnly);
+  if (! QBase64Decode(enc, dec))
+    fail(data.size(), "streaming decode reported an error");
+  if (decoded != data)
+    fail(data.size(), "streaming decode does not round-trip");
+}
+
+static void checkStrings(const QByteArray &data)
+{
+  QByteArray expected = data.toBase64();
+
+  QByteArray plain(data);
+  QBuffer in(&plain);
+  in.open(QIODevice::ReadOnly);
+  QString encoded = QBase64Encode(in);
+
+  if (! layoutOk(encoded.toLatin1()))
+    fail(data.size(), "string encode line layout is wrong");
+  if (withoutNewlines(encoded.toLatin1()) != expected)
+    fail(data.size(), "string encode differs from QByteArray::toBase64");
+
+  if (QBase64Decode(encoded) != data)
+    fail(data.size(), "string decode does not round-trip");
+  if (QBase64Decode(QString::fromLatin1(expected)) != data)
+    fail(data.size(), "string decode of QByteArray::toBase64 output is wrong");
+  if (QByteArray::fromBase64(encoded.toLatin1()) != data)
+    fail(data.size(), "QByteArray::fromBase64 cannot read the encoded text");
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  QList<int> sizes;
+  for (int i = 0; i < 200; i++)
+    sizes << i;
+
+  // the encoder works in blocks of 57 KB and the decoder in 64 KB
+  int blocks[] = { 57 * 1024, 2 * 57 * 1024, 64 * 1024 / 4 * 3, 64 * 1024 };
+  for (unsigned int b = 0; b < sizeof(blocks) / sizeof(blocks[0]); b++)
+    for (int delta = -3; delta <= 3; delta++)
+      sizes << blocks[b] + delta;
+
+  sizes << 1024 * 1024 << 20 * 1024 * 1024 + 1;
+
+  for (int i = 0; i < sizes.size(); i++)
+  {
+    QByteArray data = randomBytes(sizes.at(i));
+    checkStreams(data);
+    checkStrings(data);
+  }
+
+  // the QString overloads need several copies, so the largest buffer
+  // only goes through the streaming overloads
+  int largest = 100 * 1024 * 1024 + 2;
+  checkStreams(randomBytes(largest));
+
+  out << sizes.size() + 1 << " buffers checked, up to " << largest
+      << " bytes, " << failures << " failures\n";
+  return failures == 0 ? 0 : 1;
+}
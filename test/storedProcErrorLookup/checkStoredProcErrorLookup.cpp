@@ -0,0 +1,141 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+/* Compares the compiled error lookup table against the algorithm it
+   replaced, which kept a QMultiHash per procedure and resolved forward
+   proxies by scanning the rest of the table. The source is included so
+   the check can see the static errors[] table and initErrorLookupHash().
+ */
+
+#include <QApplication>
+#include <QMultiHash>
+#include <QTextStream>
+
+#include "storedProcErrorLookup.cpp"
+
+typedef QMultiHash< QString, QPair<int, QString> > OldLookupHash;
+
+static bool oldInitErrorLookupHash(OldLookupHash &hash)
+{
+  bool ok = true;
+  unsigned int numElems = sizeof(errors) / sizeof(errors[0]);
+  for (unsigned int i = 0; i < numElems; i++)
+  {
+    QPair<int, QString> currPair;
+    if (errors[i].msgPtr == 0)
+      currPair = qMakePair(errors[i].retVal, QCoreApplication::translate("storedProcErrorLookup", errors[i].msg));
+    else
+    {
+      QString proxyname;
+      if (qstrlen(errors[i].proxyName) == 0)
+        proxyname = QString(errors[i].procName).toUpper();
+      else
+        proxyname = QString(errors[i].proxyName).toUpper();
+
+      QList<QPair<int, QString> > proxyList = hash.values(proxyname);
+      if (proxyList.size() > 0)
+      {
+        int proxyIndex;
+        for (proxyIndex = 0; proxyIndex < proxyList.size(); proxyIndex++)
+        {
+          if (proxyList.at(proxyIndex).first == errors[i].msgPtr)
+          {
+            currPair = qMakePair(errors[i].retVal,
+                                 QString(proxyList.at(proxyIndex).second));
+            break;
+          }
+        }
+        if (proxyIndex >= proxyList.size())
+        {
+          ok = false;
+          continue;
+        }
+      }
+      else
+      {
+        unsigned int j;
+        for (j = i + 1; j < numElems; j++)
+        {
+          if (errors[j].retVal == errors[i].msgPtr &&
+              QString(errors[j].procName).toUpper() == proxyname)
+          {
+            currPair = qMakePair(errors[i].retVal,
+                                 QString(QCoreApplication::translate("storedProcErrorLookup", errors[j].msg)));
+            break;
+          }
+        }
+        if (j >= numElems)
+        {
+          ok = false;
+          continue;
+        }
+      }
+    }
+
+    hash.insert(QString(errors[i].procName).toUpper(), currPair);
+  }
+  return ok;
+}
+
+static QString oldLookup(const OldLookupHash &hash, const QString &procName, int retVal)
+{
+  QList<QPair<int, QString> > list = hash.values(procName.toUpper());
+  for (int i = 0; i < list.size(); i++)
+    if (list.at(i).first == retVal)
+      return list.at(i).second;
+  return QString();
+}
+
+int main(int argc, char *argv[])
+{
+  QApplication app(argc, argv);
+  QTextStream out(stdout);
+
+  OldLookupHash oldHash;
+  if (! oldInitErrorLookupHash(oldHash))
+    out << "note: the table has proxies the old algorithm could not resolve" << "\n";
+
+  QHash<ErrorKey, QString> newHash;
+  initErrorLookupHash(newHash);
+
+  int failures = 0;
+  int checked  = 0;
+  unsigned int numElems = sizeof(errors) / sizeof(errors[0]);
+  for (unsigned int i = 0; i < numElems; i++)
+  {
+    QString procName = errors[i].procName;
+    int     retVal   = errors[i].retVal;
+    QString expected = oldLookup(oldHash, procName, retVal);
+    QString actual   = newHash.value(ErrorKey(procName.toUpper(), retVal));
+    checked++;
+    if (expected != actual)
+    {
+      failures++;
+      out << "mismatch for (" << procName << ", " << retVal << "):" << "\n"
+          << "  old: " << expected << "\n"
+          << "  new: " << actual << "\n";
+    }
+  }
+
+  /* the new table must not hold anything the old one could not find */
+  for (QHash<ErrorKey, QString>::const_iterator it = newHash.constBegin();
+       it != newHash.constEnd(); ++it)
+  {
+    if (oldLookup(oldHash, it.key().first, it.key().second) != it.value())
+    {
+      failures++;
+      out << "unexpected entry (" << it.key().first << ", "
+          << it.key().second << ")" << "\n";
+    }
+  }
+
+  out << checked << " entries checked, " << failures << " mismatches" << "\n";
+  return failures == 0 ? 0 : 1;
+}
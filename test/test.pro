@@ -0,0 +1,15 @@
+#
+# This file is part of the xTuple ERP: PostBooks Edition, a free and
+# open source Enterprise Resource Planning software suite,
+# Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+# It is licensed to you under the Common Public Attribution License
+# version 1.0, the full text of which (including xTuple-specific Exhibits)
+# is available at www.xtuple.com/CPAL.  By using this software, you agree
+# to be bound by its terms.
+#
+
+# Stand-alone check programs. They build against the sources in common/
+# directly and run with "make check".
+TEMPLATE = subdirs
+SUBDIRS = base64 \
+          storedProcErrorLookup
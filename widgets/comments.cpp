@@ -30,6 +30,10 @@
 #include "comment.h"
 #include "comments.h"
 
+// how many comments to fetch at a time and how much of each to show
+#define COMMENTPAGE    100
+#define PREVIEWLENGTH  1000
+
 void Comments::showEvent(QShowEvent *event)
 {
   if (event)
@@ -134,6 +138,7 @@ Comments::Comments(QWidget *pParent, const char *name) :
 {
   setObjectName(name);
   _sourceid = -1;
+  _total = 0;
   _editable = true;
   if (_strMap.isEmpty()) {
     (void)commentMap();
@@ -191,6 +196,11 @@ Comments::Comments(QWidget *pParent, const char *name) :
   _editComment->setEnabled(false);
   buttonsLayout->addWidget(_editComment);
 
+  _moreComments = new QPushButton(tr("More"), buttons);
+  _moreComments->setObjectName("_moreComments");
+  _moreComments->setEnabled(false);
+  buttonsLayout->addWidget(_moreComments);
+
   QSpacerItem *_buttonSpacer = new QSpacerItem(0, 0, QSizePolicy::Minimum, QSizePolicy::Expanding);
   buttonsLayout->addItem(_buttonSpacer);
   buttons->setLayout(buttonsLayout);
@@ -202,6 +212,7 @@ Comments::Comments(QWidget *pParent, const char *name) :
   connect(_newComment, SIGNAL(clicked()), this, SLOT( sNew()));
   connect(_viewComment, SIGNAL(clicked()), this, SLOT( sView()));
   connect(_editComment, SIGNAL(clicked()), this, SLOT(sEdit()));
+  connect(_moreComments, SIGNAL(clicked()), this, SLOT(sMore()));
   connect(_comment, SIGNAL(valid(bool)), this, SLOT(sCheckButtonPriv(bool)));
   connect(_comment, SIGNAL(itemSelected(int)), _viewComment, SLOT(animateClick()));
   connect(_browser, SIGNAL(anchorClicked(QUrl)), this, SLOT(anchorClicked(QUrl)));
@@ -290,108 +301,129 @@ void Comments::sEdit()
   refresh();
 }
 
+/* The ids of all of the comments to show. For CRM Accounts this includes
+   the comments on the account's customer, vendor and contacts.
+ */
+QString Comments::commentIdSql() const
+{
+  if(_sourcetype != "CRMA")
+    return "SELECT comment_id"
+           "  FROM comment"
+           " WHERE ( (comment_source=:source)"
+           "   AND (comment_source_id=:sourceid) )";
+
+  return "SELECT comment_id"
+         "  FROM comment"
+         " WHERE((comment_source=:source)"
+         "   AND (comment_source_id=:sourceid) ) "
+         " UNION "
+         "SELECT comment_id"
+         "  FROM crmacct, comment"
+         " WHERE((comment_source=:sourceCust)"
+         "   AND ( (crmacct_id=:sourceid) OR (crmacct_parent_id=:sourceid) )"
+         "   AND (comment_source_id=crmacct_cust_id) ) "
+         " UNION "
+         "SELECT comment_id"
+         "  FROM crmacct, comment"
+         " WHERE((comment_source=:sourceVend)"
+         "   AND ( (crmacct_id=:sourceid) OR (crmacct_parent_id=:sourceid) )"
+         "   AND (comment_source_id=crmacct_vend_id) ) "
+         " UNION "
+         "SELECT comment_id"
+         "  FROM cntct, comment"
+         " WHERE((comment_source=:sourceContact)"
+         "   AND (cntct_crmacct_id=:sourceid)"
+         "   AND (comment_source_id=cntct_id) )";
+}
+
+void Comments::bindSource(XSqlQuery &qry) const
+{
+  qry.bindValue(":source", _sourcetype);
+  qry.bindValue(":sourceid", _sourceid);
+  if(_sourcetype == "CRMA")
+  {
+    qry.bindValue(":sourceCust", "C");
+    qry.bindValue(":sourceContact", "T");
+    qry.bindValue(":sourceVend", "V");
+  }
+}
+
+/* The verbose text of one comment, trimmed to a preview unless the
+   whole comment has been fetched.
+ */
+QString Comments::commentBody(int cid, QString text, bool truncated) const
+{
+  QRegExp br("\r?\n");
+  QString html = text.replace("<", "&lt;").replace(br,"<br>\n");
+  if(truncated)
+    html += QString("... <a href=\"expand?id=%1\">%2</a>").arg(cid).arg(tr("more"));
+  return html + "</pre></blockquote>\n<hr>\n";
+}
+
 void Comments::refresh()
 {
   _browser->document()->clear();
   _editmap->clear();
   _editmap2->clear();
+  _commentIDList.clear();
+  _htmlHeads.clear();
+  _htmlBodies.clear();
+  _total = 0;
+  _moreComments->setEnabled(false);
   if(-1 == _sourceid)
   {
     _comment->clear();
     return;
   }
 
-  XSqlQuery comment;
   if(_sourcetype != "CRMA")
-  {
     _comment->hideColumn(2);
-    comment.prepare( "SELECT comment_id, comment_date, comment_source,"
-                     "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
-                     "            ELSE :none"
-                     "       END AS type,"
-                     "       comment_user,"
-                     "       firstLine(detag(comment_text)) AS first,"
-                     "       comment_text, "
-                     "       COALESCE(cmnttype_editable,false) AS editable, "
-                     "       comment_public, "
-                     "       comment_user=getEffectiveXtUser() AS self "
-                     "FROM comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
-                     "WHERE ( (comment_source=:source)"
-                     " AND (comment_source_id=:sourceid) ) "
-                     "ORDER BY comment_date DESC;" );
-  }
   else
-  {
-    // If it's CRMAccount we want to do some extra joining in our SQL
     _comment->showColumn(2);
-    comment.prepare( "SELECT comment_id, comment_date, comment_source,"
-                     "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
-                     "            ELSE :none"
-                     "       END AS type,"
-                     "       comment_user,"
-                     "       firstLine(detag(comment_text)) AS first,"
-                     "       comment_text, "
-                     "       COALESCE(cmnttype_editable,false) AS editable, "
-                     "       comment_public, "
-                     "       comment_user=getEffectiveXtUser() AS self "
-                     "  FROM comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
-                     " WHERE((comment_source=:source)"
-                     "   AND (comment_source_id=:sourceid) ) "
-                     " UNION "
-                     "SELECT comment_id, comment_date, comment_source,"
-                     "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
-                     "            ELSE :none"
-                     "       END,"
-                     "       comment_user, firstLine(detag(comment_text)),"
-                     "       comment_text, "
-                     "       COALESCE(cmnttype_editable,false) AS editable, "
-                     "       comment_public, "
-                     "       comment_user=getEffectiveXtUser() AS self "
-                     "  FROM crmacct, comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
-                     " WHERE((comment_source=:sourceCust)"
-                     "   AND ( (crmacct_id=:sourceid) OR (crmacct_parent_id=:sourceid) )"
-                     "   AND (comment_source_id=crmacct_cust_id) ) "
-                     " UNION "
-                     "SELECT comment_id, comment_date, comment_source,"
-                     "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
-                     "            ELSE :none"
-                     "       END,"
-                     "       comment_user, firstLine(detag(comment_text)),"
-                     "       comment_text, "
-                     "       COALESCE(cmnttype_editable,false) AS editable, "
-                     "       comment_public, "
-                     "       comment_user=getEffectiveXtUser() AS self "
-                     "  FROM crmacct, comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
-                     " WHERE((comment_source=:sourceVend)"
-                     "   AND ( (crmacct_id=:sourceid) OR (crmacct_parent_id=:sourceid) )"
-                     "   AND (comment_source_id=crmacct_vend_id) ) "
-                     " UNION "
-                     "SELECT comment_id, comment_date, comment_source,"
-                     "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
-                     "            ELSE :none"
-                     "       END,"
-                     "       comment_user, firstLine(detag(comment_text)),"
-                     "       comment_text, "
-                     "       COALESCE(cmnttype_editable,false) AS editable, "
-                     "       comment_public, "
-                     "       comment_user=getEffectiveXtUser() AS self "
-                     "  FROM cntct, comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
-                     " WHERE((comment_source=:sourceContact)"
-                     "   AND (cntct_crmacct_id=:sourceid)"
-                     "   AND (comment_source_id=cntct_id) ) "
-                     "ORDER BY comment_date DESC;" );
-    comment.bindValue(":sourceCust", "C");
-    comment.bindValue(":sourceContact", "T");
-    comment.bindValue(":sourceVend", "V");
-  }
+
+  XSqlQuery count;
+  count.prepare(QString("SELECT COUNT(*) AS count FROM (%1) AS ids;")
+                .arg(commentIdSql()));
+  bindSource(count);
+  count.exec();
+  if(count.first())
+    _total = count.value("count").toInt();
+
+  _comment->clear();
+  sMore();
+}
+
+/* Fetch the next page of comments, with only a preview of each comment's
+   text. The full text is fetched when a comment is expanded or viewed.
+ */
+void Comments::sMore()
+{
+  if(-1 == _sourceid)
+    return;
+
+  XSqlQuery comment;
+  comment.prepare(QString("SELECT comment_id, comment_date, comment_source,"
+                          "       CASE WHEN (cmnttype_name IS NOT NULL) THEN cmnttype_name"
+                          "            ELSE :none"
+                          "       END AS type,"
+                          "       comment_user,"
+                          "       firstLine(detag(comment_text)) AS first,"
+                          "       SUBSTR(comment_text, 1, :preview) AS comment_text,"
+                          "       (LENGTH(comment_text) > :preview) AS truncated,"
+                          "       COALESCE(cmnttype_editable,false) AS editable, "
+                          "       comment_public, "
+                          "       comment_user=getEffectiveXtUser() AS self "
+                          "  FROM comment LEFT OUTER JOIN cmnttype ON (comment_cmnttype_id=cmnttype_id) "
+                          " WHERE (comment_id IN (%1)) "
+                          " ORDER BY comment_date DESC, comment_id DESC"
+                          " LIMIT :limit OFFSET :offset;").arg(commentIdSql()));
+  bindSource(comment);
   comment.bindValue(":none", tr("None"));
-  comment.bindValue(":source", _sourcetype);
-  comment.bindValue(":sourceid", _sourceid);
+  comment.bindValue(":preview", PREVIEWLENGTH);
+  comment.bindValue(":limit", COMMENTPAGE);
+  comment.bindValue(":offset", _commentIDList.size());
   comment.exec();
 
-  QString lclHtml = "<body>";
-  QRegExp br("\r?\n");
-  _commentIDList.clear();
   while(comment.next())
   {
     _editmap->insert(comment.value("comment_id").toInt(),comment.value("editable").toBool());
@@ -399,35 +431,69 @@ void Comments::refresh()
     
     int cid = comment.value("comment_id").toInt();
     _commentIDList.push_back(cid);
-    lclHtml += comment.value("comment_date").toDateTime().toString();
-    lclHtml += " ";
-    lclHtml += comment.value("type").toString();
-    lclHtml += " ";
-    lclHtml += comment.value("comment_user").toString();
+
+    QString head;
+    head += comment.value("comment_date").toDateTime().toString();
+    head += " ";
+    head += comment.value("type").toString();
+    head += " ";
+    head += comment.value("comment_user").toString();
     if(_x_metrics && _x_metrics->boolean("CommentPublicPrivate"))
     {
-      lclHtml += " (";
+      head += " (";
       if(comment.value("comment_public").toBool())
-        lclHtml += "Public";
+        head += "Public";
       else
-        lclHtml += "Private";
-      lclHtml += ")";
+        head += "Private";
+      head += ")";
     }
     if(userCanEdit(cid))
     {
-      lclHtml += " <a href=\"edit?id=";
-      lclHtml += QString::number(cid);
-      lclHtml += "\">edit</a>";
+      head += " <a href=\"edit?id=";
+      head += QString::number(cid);
+      head += "\">edit</a>";
     }
-    lclHtml += "<p>\n<blockquote>";
-    lclHtml += comment.value("comment_text").toString().replace("<", "&lt;").replace(br,"<br>\n");
-    lclHtml += "</pre></blockquote>\n<hr>\n";
+    head += "<p>\n<blockquote>";
+    _htmlHeads.append(head);
+    _htmlBodies.append(commentBody(cid, comment.value("comment_text").toString(),
+                                   comment.value("truncated").toBool()));
   }
-  lclHtml += "</body>";
 
-  _browser->document()->setHtml(lclHtml);
-  comment.first();
-  _comment->populate(comment);
+  _browser->document()->setHtml(browserHtml());
+  _comment->populate(comment, false, XTreeWidget::Append);
+
+  _moreComments->setEnabled(_commentIDList.size() < _total);
+  _moreComments->setToolTip(tr("Showing %1 of %2 comments")
+                            .arg(_commentIDList.size()).arg(_total));
+}
+
+QString Comments::browserHtml() const
+{
+  QString html = "<body>";
+  for (int i = 0; i < _htmlHeads.size(); i++)
+    html += _htmlHeads.at(i) + _htmlBodies.at(i);
+  return html + "</body>";
+}
+
+/* Replace a comment's preview in the verbose text with its full text. */
+void Comments::sExpand(int cid)
+{
+  int i = _commentIDList.indexOf(cid);
+  if(i < 0)
+    return;
+
+  XSqlQuery fullq;
+  fullq.prepare("SELECT comment_text FROM comment WHERE (comment_id=:comment_id);");
+  fullq.bindValue(":comment_id", cid);
+  fullq.exec();
+  if(fullq.first())
+  {
+    _htmlBodies[i] = commentBody(cid, fullq.value("comment_text").toString(), false);
+
+    int pos = _browser->verticalScrollBar()->value();
+    _browser->document()->setHtml(browserHtml());
+    _browser->verticalScrollBar()->setValue(pos);
+  }
 }
 
 void Comments::setVerboseCommentList(bool vcl)
@@ -463,6 +529,14 @@ void Comments::anchorClicked(const QUrl & url)
       refresh();
     }
   }
+  else if(url.host().isEmpty() && url.path() == "expand")
+  {
+    #if QT_VERSION >= 0x050000
+    sExpand(QUrlQuery(url).queryItemValue("id").toInt());
+    #else
+    sExpand(url.queryItemValue("id").toInt());
+    #endif
+  }
   else
   {
     QDesktopServices::openUrl(url);
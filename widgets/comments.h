@@ -12,6 +12,7 @@
 #define comments_h
 
 #include <QMultiMap>
+#include <QStringList>
 
 #include <xsqlquery.h>
 
@@ -105,6 +106,8 @@ class XTUPLEWIDGETS_EXPORT Comments : public QWidget
     void sNew();
     void sView();
     void sEdit();
+    void sMore();
+    void sExpand(int);
     void refresh();
 
     void anchorClicked(const QUrl &);
@@ -122,7 +125,15 @@ class XTUPLEWIDGETS_EXPORT Comments : public QWidget
   
     static bool addToMap(int id, QString key, QString trans, QString param = QString(), QString ui = QString(), QString priv = QString());
 
+    QString commentIdSql() const;
+    void    bindSource(XSqlQuery &) const;
+    QString commentBody(int, QString, bool) const;
+    QString browserHtml() const;
+
     int                 _sourceid;
+    int                 _total;
+    QStringList         _htmlHeads;
+    QStringList         _htmlBodies;
     QList<QVariant> _commentIDList;
     bool _verboseCommentList;
     bool _editable;
@@ -132,6 +143,7 @@ class XTUPLEWIDGETS_EXPORT Comments : public QWidget
     QPushButton *_newComment;
     QPushButton *_viewComment;
     QPushButton *_editComment;
+    QPushButton *_moreComments;
     QMultiMap<int, bool> *_editmap;
     QMultiMap<int, bool> *_editmap2;
     XCheckBox *_verbose;
@@ -8,6 +8,7 @@
  * to be bound by its terms.
  */
 
+#include <QCoreApplication>
 #include <QDateTime>
 #include <QGridLayout>
 #include <QLabel>
@@ -461,6 +462,129 @@ void CurrCluster::setDataWidgetMap(XDataWidgetMapper* m)
 
 ///////////////////////////////
 
+CurrCache *CurrCache::cache()
+{
+  static CurrCache *_cache = 0;
+  if (! _cache)
+    _cache = new CurrCache(QCoreApplication::instance());
+  _cache->checkConnection();
+  return _cache;
+}
+
+CurrCache::CurrCache(QObject *parent)
+  : NotifyCache(QStringList() << "curr_rate" << "curr_symbol", parent),
+    _currenciesLoaded(false)
+{
+}
+
+double CurrCache::toLocal(const int currId, const double value, const QDate &effective, QString *error)
+{
+  return convert("currToLocal", currId, -1, value, effective, error);
+}
+
+double CurrCache::toBase(const int currId, const double value, const QDate &effective, QString *error)
+{
+  return convert("currToBase", currId, -1, value, effective, error);
+}
+
+double CurrCache::toCurr(const int fromId, const int toId, const double value, const QDate &effective, QString *error)
+{
+  return convert("currToCurr", fromId, toId, value, effective, error);
+}
+
+/* Run one of the server's conversion functions, or reuse its earlier
+   result for the same arguments. toId < 0 means the function takes a
+   single currency. On failure return 0 and set error to the database
+   message so callers can keep reporting "No exchange rate".
+ */
+double CurrCache::convert(const QString &function, const int fromId, const int toId,
+                          const double value, const QDate &effective, QString *error)
+{
+  QString key = QString("%1:%2:%3:%4:%5").arg(function).arg(fromId).arg(toId)
+                  .arg(value, 0, 'g', 17).arg(effective.toString(Qt::ISODate));
+  if (_conversions.contains(key))
+    return _conversions.value(key);
+
+  XSqlQuery convq;
+  if (toId < 0)
+  {
+    convq.prepare(QString("SELECT %1(:from, :value, :date) AS result;").arg(function));
+  }
+  else
+  {
+    convq.prepare(QString("SELECT %1(:from, :to, :value, :date) AS result;").arg(function));
+    convq.bindValue(":to", toId);
+  }
+  convq.bindValue(":from",  fromId);
+  convq.bindValue(":value", value);
+  convq.bindValue(":date",  effective);
+  convq.exec();
+  if (convq.first())
+  {
+    double result = convq.value("result").toDouble();
+    _conversions.insert(key, result);
+    return result;
+  }
+  else if (error && convq.lastError().type() != QSqlError::NoError)
+    *error = convq.lastError().databaseText();
+
+  return 0.0;
+}
+
+QString CurrCache::currConcat(const int currId)
+{
+  if (! _currenciesLoaded && ! loadCurrencies())
+    return QString();
+  return _concat.value(currId);
+}
+
+QString CurrCache::symbol(const int currId)
+{
+  if (! _currenciesLoaded && ! loadCurrencies())
+    return QString();
+  return _symbol.value(currId);
+}
+
+bool CurrCache::loadCurrencies()
+{
+  XSqlQuery currq;
+  currq.prepare("SELECT curr_id, curr_symbol,"
+                "       currConcat(curr_id) AS currConcat"
+                "  FROM curr_symbol;");
+  currq.exec();
+  if (currq.lastError().type() != QSqlError::NoError)
+  {
+    QMessageBox::critical(0, tr("A System Error occurred at %1::%2.")
+                          .arg(__FILE__)
+                          .arg(__LINE__),
+                          currq.lastError().databaseText());
+    return false;
+  }
+
+  _concat.clear();
+  _symbol.clear();
+  while (currq.next())
+  {
+    _concat.insert(currq.value("curr_id").toInt(),
+                   currq.value("currConcat").toString());
+    _symbol.insert(currq.value("curr_id").toInt(),
+                   currq.value("curr_symbol").toString());
+  }
+  // ids that aren't in curr_symbol, such as -1, stay empty until a reload
+  _currenciesLoaded = true;
+  return true;
+}
+
+void CurrCache::clear()
+{
+  _conversions.clear();
+  _concat.clear();
+  _symbol.clear();
+  _currenciesLoaded = false;
+}
+
+///////////////////////////////
+
 int	CurrDisplay::_baseId	= -1;
 QString	CurrDisplay::_baseAbbr	= QString();
 int     CurrDisplay::_baseScale	= 2;
@@ -746,22 +870,17 @@ void CurrDisplay::sValueBaseChanged(double newValue)
     }
     else
     {
-	XSqlQuery convertVal;
-	convertVal.prepare("SELECT currToLocal(:curr_id, :value, :date) "
-			     " AS localValue;");
-	convertVal.bindValue(":curr_id", id());
-	convertVal.bindValue(":value", newValue);
-	convertVal.bindValue(":date", _effective);
-	convertVal.exec();
-	if (convertVal.first())
+	QString error;
+	double local = CurrCache::cache()->toLocal(id(), newValue, _effective, &error);
+	if (error.isEmpty())
 	{
-	    _valueLocal = convertVal.value("localValue").toDouble();
+	    _valueLocal = local;
 	    sZeroErrorCount(id(), effective());
 	    _localKnown = true;
 	}
-	else if (convertVal.lastError().type() != QSqlError::NoError)
+	else
 	{
-	    if (convertVal.lastError().databaseText().contains("No exchange rate"))
+	    if (error.contains("No exchange rate"))
 	    {
               emit noConversionRate();
               sNoConversionRate(this, id(), effective(), "sValueBaseChanged");
@@ -770,7 +889,7 @@ void CurrDisplay::sValueBaseChanged(double newValue)
 	      QMessageBox::critical(this, tr("A System Error occurred at %1::%2.")
 				    .arg(__FILE__)
 				    .arg(__LINE__),
-				    convertVal.lastError().databaseText());
+				    error);
 	    _localKnown = false;
 	}
     }
@@ -810,22 +929,17 @@ void CurrDisplay::sValueLocalChanged(double newValue)
     }
     else
     {
-	XSqlQuery convertVal;
-	convertVal.prepare("SELECT currToBase(:curr_id, :value, :date) "
-			   " AS baseValue;");
-	convertVal.bindValue(":curr_id", id());
-	convertVal.bindValue(":value", newValue);
-	convertVal.bindValue(":date", _effective);
-	convertVal.exec();
-	if (convertVal.first())
+	QString error;
+	double base = CurrCache::cache()->toBase(id(), newValue, _effective, &error);
+	if (error.isEmpty())
 	{
-	    _valueBase = convertVal.value("baseValue").toDouble();
-	      sZeroErrorCount(id(), effective());
-	      _baseKnown = true;
+	    _valueBase = base;
+	    sZeroErrorCount(id(), effective());
+	    _baseKnown = true;
 	}
-	else if (convertVal.lastError().type() != QSqlError::NoError)
+	else
 	{
-	    if (convertVal.lastError().databaseText().contains("No exchange rate"))
+	    if (error.contains("No exchange rate"))
 	    {
               emit noConversionRate();
               sNoConversionRate(this, id(), effective(), "sValueLocalChanged");
@@ -834,7 +948,7 @@ void CurrDisplay::sValueLocalChanged(double newValue)
 	      QMessageBox::critical(this, tr("A System Error occurred at %1::%2.")
 				    .arg(__FILE__)
 				    .arg(__LINE__),
-				    convertVal.lastError().databaseText());
+				    error);
 	    _baseKnown = false;
 	}
     }
@@ -895,37 +1009,14 @@ bool CurrDisplay::isZero() const
 	return ABS(_valueBase) < EPSILON(_baseScale);
 }
 
-// cache it?
 QString	CurrDisplay::currAbbr() const
 {
-    QString returnValue("");
-
-    XSqlQuery getAbbr;
-    getAbbr.prepare("SELECT currConcat(:curr_id) AS currConcat;");
-    getAbbr.bindValue(":curr_id", id());
-    getAbbr.exec();
-    if (getAbbr.first())
-	returnValue = getAbbr.value("currConcat").toString();
-    else if (getAbbr.lastError().type() != QSqlError::NoError)
-	QMessageBox::critical(0, tr("A System Error occurred at %1::%2.")
-			      .arg(__FILE__)
-			      .arg(__LINE__),
-			      getAbbr.lastError().databaseText());
-    return returnValue;
+    return CurrCache::cache()->currConcat(id());
 }
 
 QString CurrDisplay::currSymbol(const int pid)
 {
-  XSqlQuery symq;
-  symq.prepare("SELECT curr_symbol FROM curr_symbol WHERE (curr_id=:id);");
-  symq.bindValue(":id", pid);
-  if (symq.first())
-      return symq.value("curr_symbol").toString();
-  else if (symq.lastError().type() != QSqlError::NoError)
-      QMessageBox::critical(0, tr("A System Error occurred at %1::%2.")
-						  .arg(__FILE__).arg(__LINE__),
-			    symq.lastError().databaseText());
-  return "";
+  return CurrCache::cache()->symbol(pid);
 }
 
 void CurrDisplay::setPaletteForegroundColor(const QColor &newColor)
@@ -958,25 +1049,18 @@ double CurrDisplay::convert(const int from, const int to, const double amount, c
   if (from == to)
     return amount;
 
-  XSqlQuery convq;
-  convq.prepare("SELECT currToCurr(:from, :to, :amount, :date) AS result;");
-  convq.bindValue(":from",   from);
-  convq.bindValue(":to",     to);
-  convq.bindValue(":amount", amount);
-  convq.bindValue(":date",   date);
-  convq.exec();
-  if (convq.first())
-    return convq.value("result").toDouble();
-  else if (convq.lastError().type() != QSqlError::NoError)
-  {
-    if (convq.lastError().databaseText().contains("No exchange rate"))
-      sNoConversionRate(0, from, date, "convert");
-    else
-      QMessageBox::critical(0, tr("A System Error occurred at %1::%2.")
-			    .arg(__FILE__)
-			    .arg(__LINE__),
-			    convq.lastError().databaseText());
-  }
+  QString error;
+  double result = CurrCache::cache()->toCurr(from, to, amount, date, &error);
+  if (error.isEmpty())
+    return result;
+
+  if (error.contains("No exchange rate"))
+    sNoConversionRate(0, from, date, "convert");
+  else
+    QMessageBox::critical(0, tr("A System Error occurred at %1::%2.")
+                          .arg(__FILE__)
+                          .arg(__LINE__),
+                          error);
   return 0.0;
 }
 
@@ -13,16 +13,56 @@
 
 #include <QWidget>
 #include <QDateTime>
+#include <QHash>
+#include <QStringList>
 
 class QDoubleValidator;
 class QGridLayout;
 class QLabel;
 class QScriptEngine;
 
+#include "notifycache.h"
 #include "widgets.h"
 #include "xcombobox.h"
 #include "xlineedit.h"
 
+/*
+ Process-wide cache of currency descriptions and conversions so CurrDisplay
+ does not need a round trip for every amount it has already converted.
+ Conversions are still done by currToLocal, currToBase and currToCurr, so
+ the results keep the server's NUMERIC arithmetic, and are kept by function,
+ currencies, amount and date. The whole cache is dropped when curr_rate or
+ curr_symbol send a notification or the connection is lost.
+ */
+class XTUPLEWIDGETS_EXPORT CurrCache : public NotifyCache
+{
+  Q_OBJECT
+
+  public:
+    static CurrCache *cache();
+
+    double  toLocal(const int currId, const double value, const QDate &effective, QString *error = 0);
+    double  toBase(const int currId, const double value, const QDate &effective, QString *error = 0);
+    double  toCurr(const int fromId, const int toId, const double value, const QDate &effective, QString *error = 0);
+    QString currConcat(const int currId);
+    QString symbol(const int currId);
+
+  public slots:
+    virtual void clear();
+
+  protected:
+    CurrCache(QObject *parent = 0);
+
+    double convert(const QString &function, const int fromId, const int toId,
+                   const double value, const QDate &effective, QString *error);
+    bool loadCurrencies();
+
+    QHash<QString, double> _conversions;
+    QHash<int, QString>    _concat;
+    QHash<int, QString>    _symbol;
+    bool                   _currenciesLoaded;
+};
+
 /*
  There are several places where all we need is a widget that shows a currency
  value.  It has to internally hold a value in the base currency but show it
@@ -25,6 +25,7 @@
 #include "errorReporter.h"
 #include "../common/shortcuts.h"
 #include "imageview.h"
+#include "urlstream.h"
 
 #define DEBUG false
 
@@ -202,7 +203,8 @@ void docAttach::set(const ParameterList &pParams)
     if (DEBUG) qDebug() << "got url_id" << param;
     XSqlQuery qry;
     _urlid = param.toInt();
-    qry.prepare("SELECT url_source, url_source_id, url_title, url_url, url_stream "
+    qry.prepare("SELECT url_source, url_source_id, url_title, url_url,"
+                "       COALESCE(LENGTH(url_stream), 0) AS stream_length "
                 "  FROM url"
                 " WHERE (url_id=:url_id);" );
     qry.bindValue(":url_id", _urlid);
@@ -222,11 +224,11 @@ void docAttach::set(const ParameterList &pParams)
         if (DEBUG)
           qDebug() << "file title:"    << qry.value("url_title").toString()
                    << " text:"         << url.toString()
-                   << "stream length:" << qry.value("url_stream").toString().length();
+                   << "stream length:" << qry.value("stream_length").toLongLong();
         _docType->setId(-2);
         _filetitle->setText(qry.value("url_title").toString());
         _file->setText(url.toString());
-        if (qry.value("url_stream").toString().length())
+        if (qry.value("stream_length").toLongLong() > 0)
         {
           _fileList->setEnabled(false);
           _file->setEnabled(false);
@@ -313,6 +315,8 @@ void docAttach::sSave()
   XSqlQuery newDocass;
   QString title;
   QUrl url;
+  unsigned int streamoid = 0;   // large object holding a file saved to the db
+  qint64 streamlength = 0;
 
   //set the purpose
   if (_docAttachPurpose->currentIndex() == 0)
@@ -410,7 +414,6 @@ void docAttach::sSave()
       return;
     }
 
-    QByteArray  bytarr;
     QFileInfo fi(url.toLocalFile());
 
     if(_saveDbCheck->isChecked() &&
@@ -431,13 +434,19 @@ void docAttach::sSave()
                                 .arg(url.toLocalFile()));
         return;
       }
-      bytarr = sourceFile.readAll();
+      QSqlError err = UrlStream::store(sourceFile, streamoid, streamlength);
+      if (err.type() != QSqlError::NoError)
+      {
+        ErrorReporter::error(QtCriticalMsg, this, tr("Error Saving File"),
+                             err, __FILE__, __LINE__);
+        return;
+      }
       url.setPath(fi.fileName().remove(" "));
       url.setScheme("");
     }
 
     // TODO: replace use of URL view
-    if (_mode == "new" && bytarr.isNull())
+    if (_mode == "new" && streamoid == 0)
       newDocass.prepare( "INSERT INTO url "
                          "( url_source, url_source_id, url_title, url_url, url_stream ) "
                          "VALUES "
@@ -446,7 +455,8 @@ void docAttach::sSave()
       newDocass.prepare( "INSERT INTO url "
                          "( url_source, url_source_id, url_title, url_url, url_stream ) "
                          "VALUES "
-                         "( :docass_source_type, :docass_source_id, :title, :url, :stream );" );
+                         "( :docass_source_type, :docass_source_id, :title, :url, " +
+                         UrlStream::streamSql() + " );" );
     else
       newDocass.prepare( "UPDATE url SET "
                          "  url_title = :title, "
@@ -455,7 +465,9 @@ void docAttach::sSave()
     newDocass.bindValue(":url_id", _urlid);
     newDocass.bindValue(":title", title);
     newDocass.bindValue(":url", url.toString());
-    newDocass.bindValue(":stream", bytarr);
+    newDocass.bindValue(":stream", QByteArray());
+    newDocass.bindValue(":streamoid", streamoid);
+    newDocass.bindValue(":streamlength", (int)streamlength);
   }
   else
   {
@@ -471,6 +483,7 @@ void docAttach::sSave()
   {
     QMessageBox::critical(this,tr("Invalid Selection"),
                           tr("You may not attach a document to itself."));
+    UrlStream::discard(streamoid);
     return;
   }
 
@@ -480,6 +493,10 @@ void docAttach::sSave()
   newDocass.bindValue(":docass_purpose", _purpose);
 
   newDocass.exec();
+  UrlStream::discard(streamoid);
+  if (ErrorReporter::error(QtCriticalMsg, this, tr("Error Saving Document"),
+                           newDocass, __FILE__, __LINE__))
+    return;
 
   accept();
   return;
@@ -30,6 +30,7 @@
 #include "imageview.h"
 #include "imageAssignment.h"
 #include "docAttach.h"
+#include "urlstream.h"
 
 QMap<QString, struct DocumentMap*> Documents::_strMap;
 QMap<int,     struct DocumentMap*> Documents::_intMap;
@@ -298,7 +299,7 @@ void Documents::sOpenDoc(QString mode)
     }
 
     XSqlQuery qfile;
-    qfile.prepare("SELECT url_id, url_source_id, url_source, url_title, url_url, url_stream"
+    qfile.prepare("SELECT url_id, url_source_id, url_source, url_title, url_url"
                   " FROM url"
                   " WHERE (url_id=:url_id);");
 
@@ -334,7 +335,14 @@ void Documents::sOpenDoc(QString mode)
                              tr("Could Not Create File %1.").arg(tfile.fileName()) );
         return;
       }
-      tfile.write(qfile.value("url_stream").toByteArray());
+      QSqlError err = UrlStream::read(qfile.value("url_id").toInt(), tfile);
+      if (err.type() != QSqlError::NoError)
+      {
+        tfile.close();
+        ErrorReporter::error(QtCriticalMsg, this, tr("Error Getting Assignment"),
+                             err, __FILE__, __LINE__);
+        return;
+      }
       QUrl urldb;
       urldb.setUrl(tfile.fileName());
 #ifndef Q_OS_WIN
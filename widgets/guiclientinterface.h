@@ -38,6 +38,7 @@ class GuiClientInterface : public QObject
 
   signals:
     void dbConnectionLost();
+    void spellCheckerReady();
 };
 
 #endif
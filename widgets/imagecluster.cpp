@@ -15,7 +15,7 @@
 #include <QPixmap>
 #include <QScrollArea>
 
-#include <quuencode.h>
+#include <imagecache.h>
 #include <xsqlquery.h>
 
 #include "xcheckbox.h"
@@ -65,20 +65,10 @@ void ImageCluster::sRefresh()
   }
   else
   {
-    XSqlQuery data;
-    data.prepare("SELECT image_data FROM image WHERE image_id=:image_id");
-    data.bindValue(":image_id", id());
-    data.exec();
-    if (data.first())
-    {
-      if (DEBUG)
-        qDebug("ImageCluster::sRefresh() has picture %s, %d",
-               qPrintable(_description->text().right(128)),
-               data.value("image_data").toString().length());
-      QImage tmpImage;
-      tmpImage.loadFromData(QUUDecode(data.value("image_data").toString()));
-      _image->setPixmap(QPixmap::fromImage(tmpImage));
-    }
+    if (DEBUG)
+      qDebug("ImageCluster::sRefresh() has picture %s",
+             qPrintable(_description->text().right(128)));
+    _image->setPixmap(ImageCache::cache()->pixmap(id()));
   }
 
   if (DEBUG)
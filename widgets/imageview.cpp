@@ -12,6 +12,7 @@
 #include "widgets.h"
 #include "shortcuts.h"
 
+#include <imagecache.h>
 #include <xsqlquery.h>
 
 #include <QVariant>
@@ -124,7 +125,7 @@ void imageview::set(const ParameterList &pParams)
 void imageview::populate()
 {
   XSqlQuery image;
-  image.prepare( "SELECT image_name, image_descrip, image_data "
+  image.prepare( "SELECT image_name, image_descrip, md5(image_data) AS image_hash "
                  "FROM image "
                  "WHERE (image_id=:image_id);" );
   image.bindValue(":image_id", _imageviewid);
@@ -134,7 +135,8 @@ void imageview::populate()
     _name->setText(image.value("image_name").toString());
     _descrip->setText(image.value("image_descrip").toString());
 
-    __imageview.loadFromData(QUUDecode(image.value("image_data").toString()));
+    __imageview = ImageCache::cache()->image(_imageviewid,
+                                             image.value("image_hash").toString());
     _imageview->setPixmap(QPixmap::fromImage(__imageview));
   }
 }
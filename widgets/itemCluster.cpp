@@ -560,77 +560,42 @@ void ItemLineEdit::sCopy()
   return;
 }
 
-void ItemLineEdit::sHandleCompleter()
+QString ItemLineEdit::completerSql() const
 {
-  if (DEBUG) qDebug("%s::sHandleCompleter() entered", qPrintable(objectName()));
-  if (!hasFocus())
-    return;
-
-  QString stripped = text().trimmed().toUpper();
-  if (stripped.isEmpty())
-    return;
-
-  int width = 0;
-  QSqlQueryModel* model = static_cast<QSqlQueryModel *>(_completer->model());
-  QTreeView * view = static_cast<QTreeView *>(_completer->popup());
-  _parsed = true;
-  XSqlQuery numQ;
-
   if (_useQuery)
-  {
-    numQ.prepare(QString("SELECT *"
-                         "  FROM (%1) data"
-                         " WHERE (POSITION(:number IN item_number)=1)"
-                         " LIMIT 10")
-                 .arg(QString(_sql)).remove(";"));
-    numQ.bindValue(":number", stripped);
-  }
-  else
-  {
-    QString pre( "SELECT DISTINCT item_id, item_number, "
-                 "(item_descrip1 || ' ' || item_descrip2) AS itemdescrip, "
-                 "item_upccode AS description " );
-
-    QStringList clauses;
-    clauses = _extraClauses;
-    clauses << "((POSITION(:searchString IN item_number) = 1)"
-            " OR (POSITION(:searchString IN item_upccode) = 1))";
-    numQ.prepare(buildItemLineEditQuery(pre, clauses, QString::null, _type, true)
-                              .replace(";"," ORDER BY item_number LIMIT 10;"));
-    numQ.bindValue(":searchString", QString(text().trimmed().toUpper()));
-  }
+    return QString("SELECT *"
+                   "  FROM (%1) data"
+                   " WHERE (POSITION(:number IN item_number)=1)"
+                   " LIMIT %2")
+           .arg(QString(_sql).remove(";")).arg(COMPLETERLIMIT);
+
+  QString pre( "SELECT DISTINCT item_id, item_number, "
+               "(item_descrip1 || ' ' || item_descrip2) AS itemdescrip, "
+               "item_upccode AS description " );
+
+  QStringList clauses;
+  clauses = _extraClauses;
+  clauses << "((POSITION(:number IN item_number) = 1)"
+          " OR (POSITION(:number IN item_upccode) = 1))";
+  return buildItemLineEditQuery(pre, clauses, QString::null, _type, true)
+           .replace(";", QString(" ORDER BY item_number LIMIT %1;").arg(COMPLETERLIMIT));
+}
 
-  numQ.exec();
-  if (numQ.first())
-  {
-    int numberCol = numQ.record().indexOf("item_number");
-    int descripCol = numQ.record().indexOf("itemdescrip");
-    model->setQuery(numQ);
-    _completer->setCompletionPrefix(stripped);
-    for (int i = 0; i < model->columnCount(); i++)
-    {
-      if ( (i == numberCol) ||
-           (i == descripCol) )
-      {
-        view->resizeColumnToContents(i);
-        width += view->columnWidth(i);
-      }
-      else
-        view->hideColumn(i);
-    }
-  }
-  else
-    model->setQuery(QSqlQuery());
+QString ItemLineEdit::completerValue(const QString &pPrefix) const
+{
+  return pPrefix;
+}
 
-  if (width > 350)
-    width = 350;
+bool ItemLineEdit::completerMatches(const QSqlRecord &pRecord, const QString &pPrefix) const
+{
+  if (pRecord.value("item_number").toString().startsWith(pPrefix))
+    return true;
+  return ! _useQuery && pRecord.value("description").toString().startsWith(pPrefix);
+}
 
-  QRect rect;
-  rect.setHeight(height());
-  rect.setWidth(width);
-  rect.setBottomLeft(QPoint(0, height() - 2));
-  _completer->complete(rect);
-  _parsed = false;
+QStringList ItemLineEdit::completerColumns() const
+{
+  return QStringList() << "item_number" << "itemdescrip";
 }
 
 void ItemLineEdit::sUpdateMenu()
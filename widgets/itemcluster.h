@@ -161,7 +161,6 @@ friend class ItemLineEditDelegate;
     Q_INVOKABLE bool    isFractional();
 
   public slots:
-    void sHandleCompleter();
     void sInfo();
     void sCopy();
     void sList();
@@ -195,6 +194,12 @@ friend class ItemLineEditDelegate;
     itemSearch* searchFactory();
     void sUpdateMenu();
 
+  protected:
+    QString     completerSql() const;
+    QString     completerValue(const QString &pPrefix) const;
+    bool        completerMatches(const QSqlRecord &pRecord, const QString &pPrefix) const;
+    QStringList completerColumns() const;
+
   private:
     void constructor();
 
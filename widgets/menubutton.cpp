@@ -10,8 +10,8 @@
 
 #include "menubutton.h"
 
+#include <imagecache.h>
 #include <parameter.h>
-#include <quuencode.h>
 #include <xsqlquery.h>
 
 #include <QImage>
@@ -131,24 +131,12 @@ void MenuButton::setImage(const QString & image)
 
   if (_shown)
   {
-    XSqlQuery qry;
-    qry.prepare("SELECT image_data "
-                "FROM image "
-                "WHERE (image_name=:image);");
-    qry.bindValue(":image", _image);
-    qry.exec();
-    if (qry.first())
+    QPixmap pixmap = ImageCache::cache()->pixmap(_image);
+    if (! pixmap.isNull())
     {
-      QImage img;
-      img.loadFromData(QUUDecode(qry.value("image_data").toString()));
-      _button->setIcon(QIcon(QPixmap::fromImage(img)));
+      _button->setIcon(QIcon(pixmap));
       return;
     }
-    else if (qry.lastError().type() != QSqlError::NoError)
-      QMessageBox::critical(this, tr("A System Error occurred at %1::%2.")
-                            .arg(__FILE__)
-                            .arg(__LINE__),
-                            qry.lastError().databaseText());
     _button->setIcon(QIcon(QPixmap(":/widgets/images/folder_zoom_64.png")));
   }
 }
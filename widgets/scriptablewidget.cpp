@@ -19,9 +19,8 @@
 #include <QSqlDriver>
 
 #include "guiclientinterface.h"
-#include "include.h"
-#include "qtsetup.h"
 #include "scriptcache.h"
+#include "scriptenginepool.h"
 #include "widgets.h"
 #include "xsqlquery.h"
 
@@ -49,15 +48,13 @@ QScriptEngine *ScriptableWidget::engine()
   QWidget *w = _self;
   if (w && ! _engine)
   {
-    _engine = new QScriptEngine(w);
+    _engine = ScriptEnginePool::pool()->checkout(w);
     if (_x_preferences && _x_preferences->boolean("EnableScriptDebug"))
     {
       _debugger = new QScriptEngineDebugger(w);
       _debugger->attachTo(_engine);
     }
 
-    setupQt(_engine);
-    setupInclude(_engine);
     QScriptValue mywidget = _engine->newQObject(w);
     _engine->globalObject().setProperty("mywidget",  mywidget);
   }
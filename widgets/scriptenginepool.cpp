@@ -0,0 +1,151 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#include "scriptenginepool.h"
+
+#include <QApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QScriptEngine>
+
+#include "include.h"
+#include "qtsetup.h"
+
+#define DEBUG false
+
+#define REFILLDELAY   1000 // ms after a checkout before building a replacement
+#define POOLSIZE      0 // off unless the ScriptEnginePoolSize preference asks for engines
+
+static const char *globalsProperty = "_xtScriptGlobalsLoaded";
+
+ScriptEnginePool *ScriptEnginePool::_pool = 0;
+
+ScriptEnginePool *ScriptEnginePool::pool()
+{
+  if (! _pool)
+    _pool = new ScriptEnginePool(qApp);
+  return _pool;
+}
+
+ScriptEnginePool::ScriptEnginePool(QObject *parent)
+  : QObject(parent),
+    _init(0),
+    _size(POOLSIZE)
+{
+  setObjectName("ScriptEnginePool");
+
+  if (_x_preferences && ! _x_preferences->value("ScriptEnginePoolSize").isEmpty())
+    _size = qMax(0, _x_preferences->value("ScriptEnginePoolSize").toInt());
+
+  _refillTimer.setSingleShot(true);
+  connect(&_refillTimer, SIGNAL(timeout()), this, SLOT(sRefill()));
+}
+
+ScriptEnginePool::~ScriptEnginePool()
+{
+  clear();
+  if (_pool == this)
+    _pool = 0;
+}
+
+/*! Return a fully set up QScriptEngine owned by \a owner.
+    A warm engine is used if one is ready, otherwise one is built on the spot
+    exactly as ScriptableWidget used to do.
+ */
+QScriptEngine *ScriptEnginePool::checkout(QObject *owner)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QScriptEngine *engine = 0;
+  if (! _engines.isEmpty())
+    engine = _engines.takeFirst();
+  else
+    engine = create();
+
+  engine->setParent(owner);
+
+  if (DEBUG)
+    qDebug() << "ScriptEnginePool::checkout() took" << timer.elapsed()
+             << "ms," << _engines.size() << "warm engines left";
+
+  if (_size > 0)
+    _refillTimer.start(REFILLDELAY);
+
+  return engine;
+}
+
+/*! Return true if the application's initializer has already run on \a engine.
+ */
+bool ScriptEnginePool::hasGlobals(QScriptEngine *engine) const
+{
+  return engine && engine->property(globalsProperty).toBool();
+}
+
+/*! Set the function that loads application-wide script globals, such as
+    mainwindow and toolbox, into each new engine. Engines already in the
+    pool were built without it so they are thrown away.
+ */
+void ScriptEnginePool::setInitializer(Initializer init)
+{
+  _init = init;
+  clear();
+  if (_size > 0)
+    _refillTimer.start(REFILLDELAY);
+}
+
+void ScriptEnginePool::setSize(int size)
+{
+  _size = qMax(0, size);
+  while (_engines.size() > _size)
+    delete _engines.takeLast();
+  if (_engines.size() < _size)
+    _refillTimer.start(REFILLDELAY);
+}
+
+void ScriptEnginePool::clear()
+{
+  _refillTimer.stop();
+  qDeleteAll(_engines);
+  _engines.clear();
+}
+
+/* Build one engine per timeout so a long refill doesn't freeze the UI.
+ */
+void ScriptEnginePool::sRefill()
+{
+  if (_engines.size() >= _size)
+    return;
+
+  _engines.append(create());
+
+  if (_engines.size() < _size)
+    _refillTimer.start(0);
+}
+
+QScriptEngine *ScriptEnginePool::create()
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QScriptEngine *engine = new QScriptEngine(this);
+  setupQt(engine);
+  setupInclude(engine);
+  if (_init)
+  {
+    _init(engine);
+    engine->setProperty(globalsProperty, true);
+  }
+
+  if (DEBUG)
+    qDebug() << "ScriptEnginePool::create() took" << timer.elapsed() << "ms";
+
+  return engine;
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is part of the xTuple ERP: PostBooks Edition, a free and
+ * open source Enterprise Resource Planning software suite,
+ * Copyright (c) 1999-2017 by OpenMFG LLC, d/b/a xTuple.
+ * It is licensed to you under the Common Public Attribution License
+ * version 1.0, the full text of which (including xTuple-specific Exhibits)
+ * is available at www.xtuple.com/CPAL.  By using this software, you agree
+ * to be bound by its terms.
+ */
+
+#ifndef __SCRIPTENGINEPOOL_H__
+#define __SCRIPTENGINEPOOL_H__
+
+#include <QList>
+#include <QObject>
+#include <QTimer>
+
+#include "widgets.h"
+
+class QScriptEngine;
+
+/*
+    ScriptEnginePool keeps a few QScriptEngines that have already been
+    through setupQt(), setupInclude() and the application's initializer
+    so opening a scripted window doesn't have to wait for them.
+
+    Engines are handed out once and belong to the window from then on.
+    They are never recycled because a script can connect signals of
+    long-lived objects, like mainwindow, to its own functions and the
+    engine offers no way to find and drop those connections. The pool
+    refills itself a little while after each checkout instead.
+
+    The pool is empty by default, so every checkout builds its engine on
+    the spot as before. Set the ScriptEnginePoolSize user preference to
+    the number of warm engines to keep.
+*/
+class XTUPLEWIDGETS_EXPORT ScriptEnginePool : public QObject
+{
+  Q_OBJECT
+
+  public:
+    typedef void (*Initializer)(QScriptEngine *);
+
+    static ScriptEnginePool *pool();
+
+    QScriptEngine *checkout(QObject *owner);
+    bool           hasGlobals(QScriptEngine *engine) const;
+    void           setInitializer(Initializer init);
+    int            size() const { return _size; }
+    void           setSize(int size);
+
+  public slots:
+    virtual void clear();
+    virtual void sRefill();
+
+  protected:
+    ScriptEnginePool(QObject *parent = 0);
+    virtual ~ScriptEnginePool();
+
+    QScriptEngine *create();
+
+    QList<QScriptEngine *> _engines;
+    Initializer            _init;
+    int                    _size;
+    QTimer                 _refillTimer;
+
+    static ScriptEnginePool *_pool;
+};
+
+#endif
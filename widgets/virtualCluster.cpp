@@ -19,9 +19,12 @@
 #include <QMenu>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QRegExp>
 #include <QSqlError>
 #include <QSqlQueryModel>
 #include <QSqlRecord>
+#include <QStandardItemModel>
+#include <QTimer>
 #include <QVBoxLayout>
 
 #include "guiclientinterface.h"
@@ -35,6 +38,9 @@
 
 #define DEBUG false
 
+#define COMPLETERDELAY      200 // ms to wait for the user to stop typing
+#define COMPLETERCACHESIZE  100
+
 void VirtualCluster::init()
 {
   _number = 0;
@@ -319,6 +325,10 @@ VirtualClusterLineEdit::VirtualClusterLineEdit(QWidget* pParent,
     _completer = 0;
     _showInactive = false;
     _completerId = 0;
+    _completerTimer = 0;
+    _completerDelay = COMPLETERDELAY;
+    if (_x_metrics && _x_metrics->value("AutoCompleteDelay").toInt() > 0)
+      _completerDelay = _x_metrics->value("AutoCompleteDelay").toInt();
 
     setTableAndColumnNames(pTabName, pIdColumn, pNumberColumn, pNameColumn, pDescripColumn, pActiveColumn);
 
@@ -336,7 +346,7 @@ VirtualClusterLineEdit::VirtualClusterLineEdit(QWidget* pParent,
     {
       if (!_x_metrics->boolean("DisableAutoComplete"))
       {
-        QSqlQueryModel* hints = new QSqlQueryModel(this);
+        QStandardItemModel* hints = new QStandardItemModel(this);
         hints->setObjectName("hints");
 
         _completer = new QCompleter(hints,this);
@@ -354,6 +364,10 @@ VirtualClusterLineEdit::VirtualClusterLineEdit(QWidget* pParent,
         _completer->setCaseSensitivity(Qt::CaseInsensitive);
         _completer->setCompletionColumn(1);
         _completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
+        _completerTimer = new QTimer(this);
+        _completerTimer->setSingleShot(true);
+        connect(_completerTimer, SIGNAL(timeout()), this, SLOT(sRunCompleter()));
+
         connect(this, SIGNAL(textEdited(QString)), this, SLOT(sHandleCompleter()));
         connect(_completer, SIGNAL(highlighted(QString)), this, SLOT(setText(QString)));
         connect(_completer, SIGNAL(highlighted(const QModelIndex &)), this, SLOT(completerHighlighted(const QModelIndex &)));
@@ -547,9 +561,25 @@ void VirtualClusterLineEdit::setMenu(QMenu *menu)
   _menu = menu;
 }
 
+/* Called as the user types. The query itself waits for the user to pause
+   so typing a whole number costs one lookup instead of one per keystroke.
+ */
 void VirtualClusterLineEdit::sHandleCompleter()
 {
-  if (!hasFocus())
+  if (!hasFocus() || !_completer)
+    return;
+
+  if (text().trimmed().isEmpty())
+  {
+    _completerTimer->stop();
+    return;
+  }
+  _completerTimer->start(_completerDelay);
+}
+
+void VirtualClusterLineEdit::sRunCompleter()
+{
+  if (!hasFocus() || !_completer)
     return;
 
   QString stripped = text().trimmed().toUpper();
@@ -557,49 +587,69 @@ void VirtualClusterLineEdit::sHandleCompleter()
     return;
 
   int width = 0;
-  QSqlQueryModel* model = static_cast<QSqlQueryModel *>(_completer->model());
+  QStandardItemModel* model = static_cast<QStandardItemModel *>(_completer->model());
   QTreeView * view = static_cast<QTreeView *>(_completer->popup());
   _parsed = true;
-  XSqlQuery numQ;
-  numQ.prepare(_query + _numClause +
-               (_extraClause.isEmpty() || !_strict ? "" : " AND " + _extraClause) +
-               ((_hasActive && ! _showInactive) ? _activeClause : "") +
-               QString(" ORDER BY %1 LIMIT 10;").arg(_numColName));
-  numQ.bindValue(":number", "^" + stripped);
-  numQ.exec();
-  if (numQ.first())
+
+  QString sql = completerSql();
+  QList<QSqlRecord> records;
+  if (! cachedCompletions(sql, stripped, records))
   {
-    int numberCol = numQ.record().indexOf("number");
-    int nameCol = numQ.record().indexOf("name");
-    int descripCol = numQ.record().indexOf("description");
-    model->setQuery(numQ);
-    _completer->setCompletionPrefix(stripped);
+    XSqlQuery numQ;
+    numQ.prepare(sql);
+    numQ.bindValue(":number", completerValue(stripped));
+    numQ.exec();
 
-    for (int i = 0; i < model->columnCount(); i++)
+    while (numQ.next())
+      records.append(numQ.record());
+
+    if (numQ.lastError().type() == QSqlError::NoError)
     {
-      if ( (i != numberCol) &&
-           (!_hasName || i != nameCol ) &&
-           (!_hasDescription || i != descripCol) )
-      {
-        view->hideColumn(i);
-      }
+      if (_completerCache.size() >= COMPLETERCACHESIZE)
+        _completerCache.clear();
+      VirtualCompleterCacheEntry entry;
+      entry.records  = records;
+      entry.complete = records.size() < COMPLETERLIMIT;
+      _completerCache.insert(sql + QChar(0) + stripped, entry);
     }
+  }
 
-    view->resizeColumnToContents(numberCol);
-    width += view->columnWidth(numberCol);
-    if (_hasName)
+  model->clear();
+  if (! records.isEmpty())
+  {
+    QSqlRecord  first = records.first();
+    QStringList labels;
+    for (int col = 0; col < first.count(); col++)
+      labels << first.fieldName(col);
+    model->setColumnCount(first.count());
+    model->setHorizontalHeaderLabels(labels);
+
+    for (int row = 0; row < records.size(); row++)
     {
-      view->resizeColumnToContents(nameCol);
-      width += view->columnWidth(nameCol);
+      QList<QStandardItem *> items;
+      for (int col = 0; col < first.count(); col++)
+      {
+        QStandardItem *item = new QStandardItem();
+        item->setData(records.at(row).value(col), Qt::DisplayRole);
+        items << item;
+      }
+      model->appendRow(items);
     }
-    if (_hasDescription)
+    _completer->setCompletionPrefix(stripped);
+
+    QStringList shown = completerColumns();
+    for (int i = 0; i < model->columnCount(); i++)
     {
-      view->resizeColumnToContents(descripCol);
-      width += view->columnWidth(descripCol);
+      if (shown.contains(labels.at(i)))
+      {
+        view->showColumn(i);
+        view->resizeColumnToContents(i);
+        width += view->columnWidth(i);
+      }
+      else
+        view->hideColumn(i);
     }
   }
-  else
-    model->setQuery(QSqlQuery());
 
   if (width > 350)
     width = 350;
@@ -612,6 +662,86 @@ void VirtualClusterLineEdit::sHandleCompleter()
   _parsed = false;
 }
 
+/* Look for completions of pPrefix that don't need the database: either the
+   same prefix was fetched before or a shorter prefix returned fewer rows
+   than the limit, so every match for pPrefix is already in hand.
+ */
+bool VirtualClusterLineEdit::cachedCompletions(const QString &pSql, const QString &pPrefix,
+                                               QList<QSqlRecord> &pRecords) const
+{
+  QString key = pSql + QChar(0) + pPrefix;
+  if (_completerCache.contains(key))
+  {
+    pRecords = _completerCache.value(key).records;
+    return true;
+  }
+
+  /* the database matches pPrefix as a regex unless completerValue() passes
+     it through as-is, and any regex operator can make the server's answer
+     differ from the startsWith() refinement below
+   */
+  static QRegExp operators("[.^|*?+{}()\\[\\]\\\\$]");
+  if (completerValue(pPrefix) != pPrefix && pPrefix.contains(operators))
+    return false;
+
+  for (int len = pPrefix.length() - 1; len > 0; len--)
+  {
+    key = pSql + QChar(0) + pPrefix.left(len);
+    if (_completerCache.contains(key))
+    {
+      VirtualCompleterCacheEntry entry = _completerCache.value(key);
+      if (! entry.complete)
+        return false;
+
+      pRecords.clear();
+      for (int i = 0; i < entry.records.size(); i++)
+        if (completerMatches(entry.records.at(i), pPrefix))
+          pRecords.append(entry.records.at(i));
+      return true;
+    }
+  }
+  return false;
+}
+
+QString VirtualClusterLineEdit::completerSql() const
+{
+  return _query + _numClause +
+         (_extraClause.isEmpty() || !_strict ? "" : " AND " + _extraClause) +
+         ((_hasActive && ! _showInactive) ? _activeClause : "") +
+         QString(" ORDER BY %1 LIMIT %2;").arg(_numColName).arg(COMPLETERLIMIT);
+}
+
+QString VirtualClusterLineEdit::completerValue(const QString &pPrefix) const
+{
+  return "^" + pPrefix;
+}
+
+bool VirtualClusterLineEdit::completerMatches(const QSqlRecord &pRecord, const QString &pPrefix) const
+{
+  return pRecord.value("number").toString().startsWith(pPrefix, Qt::CaseInsensitive);
+}
+
+QStringList VirtualClusterLineEdit::completerColumns() const
+{
+  QStringList columns("number");
+  if (_hasName)
+    columns << "name";
+  if (_hasDescription)
+    columns << "description";
+  return columns;
+}
+
+void VirtualClusterLineEdit::clearCompleter()
+{
+  if (_completer)
+    static_cast<QStandardItemModel *>(_completer->model())->clear();
+}
+
+void VirtualClusterLineEdit::setCompleterDelay(int pDelay)
+{
+  _completerDelay = pDelay < 0 ? 0 : pDelay;
+}
+
 void VirtualClusterLineEdit::completerHighlighted(const QModelIndex & index)
 {
   _completerId = _completer->completionModel()->data(index.sibling(index.row(), 0)).toInt();
@@ -790,8 +920,7 @@ void VirtualClusterLineEdit::silentSetId(const int pId)
     idQ.exec();
     if (idQ.first())
     {
-      if (_completer)
-        static_cast<QSqlQueryModel* >(_completer->model())->setQuery(QSqlQuery());
+      clearCompleter();
 
       _id = pId;
       _valid = true;
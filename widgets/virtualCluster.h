@@ -17,7 +17,9 @@
 #include "xlineedit.h"
 
 #include <QDialog>
+#include <QHash>
 #include <QSqlQuery>
+#include <QSqlRecord>
 #include <QWidget>
 
 class GuiClientInterface;
@@ -30,6 +32,7 @@ class QMenu;
 class QPushButton;
 class QSpacerItem;
 class QSqlQueryModel;
+class QTimer;
 class QVBoxLayout;
 class VirtualClusterLineEdit;
 class XCheckBox;
@@ -41,6 +44,8 @@ class XTreeWidget;
 #define DESCRIPTION     3
 #define ACTIVE          4
 
+#define COMPLETERLIMIT  10
+
 class XTUPLEWIDGETS_EXPORT VirtualList : public QDialog, public ScriptableWidget
 {
     Q_OBJECT
@@ -141,6 +146,18 @@ class XTUPLEWIDGETS_EXPORT VirtualInfo : public QDialog, public ScriptableWidget
         int _id;
 };
 
+/*
+    Rows a VirtualClusterLineEdit fetched for one completion prefix.
+    complete is true when the query returned fewer rows than its LIMIT,
+    meaning the rows for any longer prefix are a subset of these.
+*/
+class VirtualCompleterCacheEntry
+{
+  public:
+    QList<QSqlRecord> records;
+    bool              complete;
+};
+
 /*
     VirtualClusterLineEdit is an abstract class that encapsulates
     the basics of retrieving an ID given a NUMBER or a NUMBER given
@@ -161,6 +178,7 @@ class XTUPLEWIDGETS_EXPORT VirtualInfo : public QDialog, public ScriptableWidget
 class XTUPLEWIDGETS_EXPORT VirtualClusterLineEdit : public XLineEdit
 {
     Q_OBJECT
+    Q_PROPERTY(int completerDelay READ completerDelay WRITE setCompleterDelay)
     
     friend class VirtualCluster;
     friend class VirtualInfo;
@@ -187,6 +205,9 @@ class XTUPLEWIDGETS_EXPORT VirtualClusterLineEdit : public XLineEdit
        Q_INVOKABLE inline virtual QString name()        const { return _name; }
        Q_INVOKABLE inline virtual QString description() const { return _description; }
 
+       int  completerDelay() const { return _completerDelay; }
+       void setCompleterDelay(int pDelay);
+
     public slots:
         virtual void clear();
         virtual QString extraClause() const { return _extraClause; }
@@ -216,6 +237,7 @@ class XTUPLEWIDGETS_EXPORT VirtualClusterLineEdit : public XLineEdit
 
         virtual void setStrikeOut(bool enable = false);
         virtual void sHandleCompleter();
+        virtual void sRunCompleter();
         virtual void sHandleNullStr();
         virtual void sParse();
         virtual void sUpdateMenu();
@@ -281,12 +303,23 @@ class XTUPLEWIDGETS_EXPORT VirtualClusterLineEdit : public XLineEdit
 
         virtual void silentSetId(const int);
 
+        virtual QString     completerSql() const;
+        virtual QString     completerValue(const QString &pPrefix) const;
+        virtual bool        completerMatches(const QSqlRecord &pRecord, const QString &pPrefix) const;
+        virtual QStringList completerColumns() const;
+        void                clearCompleter();
+
         QSqlQueryModel* _model;
 
     private:
         void positionMenuLabel();
+        bool cachedCompletions(const QString &pSql, const QString &pPrefix,
+                               QList<QSqlRecord> &pRecords) const;
 
         QString _cText;
+        QTimer* _completerTimer;
+        int     _completerDelay;
+        QHash<QString, VirtualCompleterCacheEntry> _completerCache;
 };
 
 /*
@@ -117,6 +117,7 @@ HEADERS += plugins/addressclusterplugin.h \
 SOURCES += widgets.cpp \
     scriptablewidget.cpp                \
     scriptcache.cpp                     \
+    scriptenginepool.cpp                \
     addressCluster.cpp \
     alarmMaint.cpp \
     alarms.cpp \
@@ -213,6 +214,7 @@ SOURCES += widgets.cpp \
 HEADERS += widgets.h \
     scriptablewidget.h          \
     scriptcache.h               \
+    scriptenginepool.h          \
     xtupleplugin.h \
     guiclientinterface.h \
     addresscluster.h \
@@ -16,7 +16,7 @@
 #include <QValidator>
 
 #include "format.h"
-#include <quuencode.h>
+#include "imagecache.h"
 #include "xsqlquery.h"
 
 #define DEBUG false
@@ -79,25 +79,7 @@ void XLabel::setImage(QString image)
     return;
 
   _data->_image = image;
-  XSqlQuery qry;
-  qry.prepare("SELECT image_data "
-              "FROM image "
-              "WHERE (image_name=:image);");
-  qry.bindValue(":image", _data->_image);
-  qry.exec();
-  if (qry.first())
-  {
-    QImage img;
-    img.loadFromData(QUUDecode(qry.value("image_data").toString()));
-    setPixmap(QPixmap::fromImage(img));
-    return;
-  }
-  else if (qry.lastError().type() != QSqlError::NoError)
-    QMessageBox::critical(this, tr("A System Error occurred at %1::%2.")
-                          .arg(__FILE__)
-                          .arg(__LINE__),
-                          qry.lastError().databaseText());
-  setPixmap(QPixmap());
+  setPixmap(ImageCache::cache()->pixmap(_data->_image));
 }
 
 void XLabel::setPrecision(QValidator *pVal)
@@ -139,6 +139,8 @@ XTextEditHighlighter::XTextEditHighlighter(QObject *parent)
     HighlightingRule rule;
     _spellCheckFormat.setUnderlineColor(QColor(Qt::red));
     _spellCheckFormat.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
+    if (_guiClientInterface)
+      connect(_guiClientInterface, SIGNAL(spellCheckerReady()), this, SLOT(rehighlight()));
 }
 
 XTextEditHighlighter::XTextEditHighlighter(QTextDocument *document)
@@ -147,6 +149,8 @@ XTextEditHighlighter::XTextEditHighlighter(QTextDocument *document)
     HighlightingRule rule;
     _spellCheckFormat.setUnderlineColor(QColor(Qt::red));
     _spellCheckFormat.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
+    if (_guiClientInterface)
+      connect(_guiClientInterface, SIGNAL(spellCheckerReady()), this, SLOT(rehighlight()));
 }
 
 XTextEditHighlighter::XTextEditHighlighter(QTextEdit *editor)
@@ -155,6 +159,8 @@ XTextEditHighlighter::XTextEditHighlighter(QTextEdit *editor)
     HighlightingRule rule;
     _spellCheckFormat.setUnderlineColor(QColor(Qt::red));
     _spellCheckFormat.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
+    if (_guiClientInterface)
+      connect(_guiClientInterface, SIGNAL(spellCheckerReady()), this, SLOT(rehighlight()));
 }
 
 XTextEditHighlighter::~XTextEditHighlighter()
@@ -19,6 +19,7 @@
 #include <QDate>
 #include <QDateTime>
 #include <QDrag>
+#include <QFile>
 #include <QFileDialog>
 #include <QFont>
 #include <QHeaderView>
@@ -26,7 +27,10 @@
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QProgressBar>
+#include <QProgressDialog>
 #include <QPushButton>
+#include <QScrollBar>
+#include <QSet>
 #include <QSqlError>
 #include <QSqlRecord>
 #include <QTextCharFormat>
@@ -37,6 +41,8 @@
 #include <QTextTable>
 #include <QTextTableCell>
 #include <QTextTableFormat>
+#include <QTreeWidgetItemIterator>
+#include <QTextStream>
 #include <QtScript>
 #include <QMessageBox>
 
@@ -49,6 +55,7 @@
 
 #define WORKERINTERVAL 0
 #define WORKERROWS     500
+#define EXPORTROWS     500
 
 /* make sure the colroles are kept in sync with
    QStringList knownroles in populate() below,
@@ -99,6 +106,347 @@ static double round(double r, int places)
   return cint(r*off)/off;
 }
 
+/* populateWorker() reads cell values straight from the query while lazy
+   items read them back from an XTreeWidgetLazyStore, so the code that turns
+   a row into item roles reads through this instead of an XSqlQuery.
+ */
+class XTreeWidgetRowSource
+{
+  public:
+    virtual ~XTreeWidgetRowSource() {}
+    virtual QVariant value(int field) const = 0;
+};
+
+class XTreeWidgetQueryRow : public XTreeWidgetRowSource
+{
+  public:
+    XTreeWidgetQueryRow(const XSqlQuery &query) : _query(query) {}
+    virtual QVariant value(int field) const { return _query.value(field); }
+
+  private:
+    const XSqlQuery &_query;
+};
+
+/* Columnar copy of the query fields a lazy populate needs.
+   Only fields referenced by a column or role are kept, one QVector per
+   field, so a row costs a handful of QVariants instead of an
+   XTreeWidgetItem full of formatted roles.
+ */
+class XTreeWidgetLazyStore
+{
+  public:
+    QVector<int>                slot;       // query field -> index in values
+    QVector<QVector<QVariant> > values;     // values[slot][row]
+    QVector<int>                colIdx;
+    QVector<QVector<int> >      colRole;
+    QVector<int>                alignment;
+    int                         deletedRole;
+    int                         defaultScale;
+
+    int append(const XSqlQuery &query)
+    {
+      for (int field = 0; field < slot.size(); field++)
+        if (slot.at(field) >= 0)
+          values[slot.at(field)].append(query.value(field));
+      return values.isEmpty() ? 0 : values.at(0).size() - 1;
+    }
+};
+
+class XTreeWidgetLazyRow : public XTreeWidgetRowSource
+{
+  public:
+    XTreeWidgetLazyRow(const XTreeWidgetLazyStore *store, int row)
+      : _store(store), _row(row) {}
+    virtual QVariant value(int field) const
+    {
+      if (field < 0 || field >= _store->slot.size() || _store->slot.at(field) < 0)
+        return QVariant();
+      return _store->values.at(_store->slot.at(field)).at(_row);
+    }
+
+  private:
+    const XTreeWidgetLazyStore *_store;
+    int                         _row;
+};
+
+static void populateItemColumn(XTreeWidgetItem *item, int col,
+                               const XTreeWidgetRowSource &row,
+                               int colIdx, const int *colRole,
+                               int deletedRole, int defaultScale,
+                               int alignment)
+{
+  QVariant rawValue;
+  if (colIdx >= 0)  //#13439 optimization - only try to retrieve value if index is valid
+    rawValue = row.value(colIdx);
+
+  item->setData(col, Xt::RawRole, rawValue);
+
+  // TODO: this isn't necessary for all columns so do less often?
+  int     scale        = defaultScale;
+  QString numericrole  = "";
+  if (colRole[COLROLE_NUMERIC])
+  {
+    // Negative NUMERIC ROLE => default for column instead of column index
+    // see populateWorker()
+    if (colRole[COLROLE_NUMERIC] < 0)
+      scale = 0 - colRole[COLROLE_NUMERIC];
+    else
+    {
+      numericrole  = row.value(colRole[COLROLE_NUMERIC]).toString();
+      scale        = decimalPlaces(numericrole);
+    }
+  }
+
+  if (colRole[COLROLE_NUMERIC] ||
+      colRole[COLROLE_RUNNING] ||
+      colRole[COLROLE_TOTAL])
+    item->setData(col, Xt::ScaleRole, scale);
+
+  /* if qtdisplayrole IS NULL then let the raw value shine through.
+     this allows UNIONS to do interesting things, like put dates and
+     text into the same visual column without SQL errors.
+  */
+  if (colRole[COLROLE_DISPLAY] &&
+      !row.value(colRole[COLROLE_DISPLAY]).isNull())
+  {
+    /* this might not handle PostgreSQL NUMERICs properly
+       but at least it will try to handle INTEGERs and DOUBLEs
+       and it will avoid formatting sales order numbers with decimal
+       and group separators
+    */
+    QVariant field = row.value(colRole[COLROLE_DISPLAY]);
+    if (field.type() == QVariant::Int)
+      item->setData(col, Qt::DisplayRole,
+                    QLocale().toString(field.toInt()));
+    else if (field.type() == QVariant::Double)
+      item->setData(col, Qt::DisplayRole,
+                    QLocale().toString(field.toDouble(),
+                                       'f', scale));
+    else
+      item->setData(col, Qt::DisplayRole, field.toString());
+  }
+  else if (rawValue.isNull())
+  {
+    item->setData(col, Qt::DisplayRole,
+                  colRole[COLROLE_NULL] ?
+                  row.value(colRole[COLROLE_NULL]).toString() :
+                  "");
+  }
+  else if (colRole[COLROLE_NUMERIC] &&
+           ((numericrole == "percent") ||
+            (numericrole == "scrap")))
+  {
+    item->setData(col, Qt::DisplayRole,
+                  QLocale().toString(rawValue.toDouble() * 100.0,
+                                     'f', scale));
+  }
+  else if (colRole[COLROLE_NUMERIC] || rawValue.type() == QVariant::Double)
+  {
+    // Issue #8897
+    item->setData(col, Qt::DisplayRole,
+                  QLocale().toString(round(rawValue.toDouble(), scale),
+                                     'f', scale));
+  }
+  else if (rawValue.type() == QVariant::Bool)
+  {
+    item->setData(col, Qt::DisplayRole,
+                  rawValue.toBool() ? yesStr : noStr);
+  }
+  else
+  {
+    item->setData(col, Qt::EditRole, rawValue);
+  }
+
+  if (colRole[COLROLE_FOREGROUND])
+  {
+    QVariant fg = row.value(colRole[COLROLE_FOREGROUND]);
+    if (!fg.isNull())
+      item->setData(col, Qt::ForegroundRole, namedColor(fg.toString()));
+  }
+
+  if (colRole[COLROLE_BACKGROUND])
+  {
+    QVariant bg = row.value(colRole[COLROLE_BACKGROUND]);
+    if (!bg.isNull())
+      item->setData(col, Qt::BackgroundRole, namedColor(bg.toString()));
+  }
+
+  if (colRole[COLROLE_TEXTALIGNMENT])
+  {
+    QVariant alignmentValue = row.value(colRole[COLROLE_TEXTALIGNMENT]);
+    if (!alignmentValue.isNull())
+      item->setData(col, Qt::TextAlignmentRole, alignmentValue);
+  }
+  else
+    item->setData(col, Qt::TextAlignmentRole, alignment);
+
+  if (colRole[COLROLE_TOOLTIP])
+  {
+    QVariant tooltip = row.value(colRole[COLROLE_TOOLTIP]);
+    if (!tooltip.isNull() )
+      item->setData(col, Qt::ToolTipRole, tooltip);
+  }
+
+  if (colRole[COLROLE_STATUSTIP])
+  {
+    QVariant statustip = row.value(colRole[COLROLE_STATUSTIP]);
+    if (!statustip.isNull())
+      item->setData(col, Qt::StatusTipRole, statustip);
+  }
+
+  if (colRole[COLROLE_FONT])
+  {
+    QVariant font = row.value(colRole[COLROLE_FONT]);
+    if (!font.isNull())
+      item->setData(col, Qt::FontRole, font);
+  }
+
+  if (colRole[COLROLE_RUNNINGINIT])
+  {
+    QVariant runninginit = row.value(colRole[COLROLE_RUNNINGINIT]);
+    if (!runninginit.isNull())
+      item->setData(col, Xt::RunningInitRole, runninginit);
+  }
+
+  if (colRole[COLROLE_ID])
+  {
+    QVariant id = row.value(colRole[COLROLE_ID]);
+    if (!id.isNull())
+      item->setData(col, Xt::IdRole, id);
+  }
+
+  if (colRole[COLROLE_TOTAL])
+  {
+    item->setData(col, Xt::TotalSetRole,
+                  row.value(colRole[COLROLE_TOTAL]).toInt());
+  }
+
+  if (deletedRole)
+  {
+    if (DEBUG)
+      qDebug("populateItemColumn() found xtdeleterole, value = %s",
+             qPrintable(row.value(deletedRole).toString()));
+    if (row.value(deletedRole).toBool())
+    {
+      item->setData(col,Xt::DeletedRole, QVariant(true));
+      QFont font = item->font(col);
+      font.setStrikeOut(true);
+      item->setFont(col, font);
+      item->setTextColor(Qt::gray);
+    }
+  }
+  /*
+  if (colRole[COLROLE_KEY])
+    item->setData(col, KeyRole, row.value(colRole[COLROLE_KEY]));
+  if (colRole[COLROLE_GROUPRUNNING])
+    item->setData(col, GroupRunningRole, row.value(colRole[COLROLE_GROUPRUNNING]));
+  */
+}
+
+/* An item created by a lazy populate holds nothing but its id, altId and
+   a row number in the shared store. The cell roles are built the first
+   time the view (or anything else) asks for them, so only rows that get
+   painted, exported or otherwise touched pay for formatting.
+ */
+class XTreeWidgetLazyItem : public XTreeWidgetItem
+{
+  public:
+    XTreeWidgetLazyItem(QSharedPointer<XTreeWidgetLazyStore> store, int row,
+                        int pId, int pAltId)
+      : XTreeWidgetItem((XTreeWidgetItem *)0, pId, pAltId),
+        _store(store),
+        _row(row),
+        _materialized(false)
+    {
+    }
+
+    virtual QVariant data(int colidx, int role) const
+    {
+      if (! _materialized)
+      {
+        // answer the sort and total-row checks without building every row
+        if (role == Xt::RawRole)
+        {
+          if (colidx < 0 || colidx >= _store->colIdx.size())
+            return QVariant();
+          return XTreeWidgetLazyRow(_store.data(), _row).value(_store->colIdx.at(colidx));
+        }
+        else if (role == Qt::UserRole)
+          return QVariant();
+
+        const_cast<XTreeWidgetLazyItem *>(this)->materialize();
+      }
+      return XTreeWidgetItem::data(colidx, role);
+    }
+
+    virtual void setData(int colidx, int role, const QVariant &val)
+    {
+      if (! _materialized)
+        materialize();
+      XTreeWidgetItem::setData(colidx, role, val);
+    }
+
+    void materialize()
+    {
+      if (_materialized)
+        return;
+      _materialized = true;
+
+      // the view is usually mid-paint; don't let it hear about every role
+      QAbstractItemModel *model = treeWidget() ? treeWidget()->model() : 0;
+      bool blocked = model ? model->blockSignals(true) : false;
+
+      XTreeWidgetLazyRow row(_store.data(), _row);
+      for (int col = 0; col < _store->colIdx.size(); col++)
+        populateItemColumn(this, col, row, _store->colIdx.at(col),
+                           _store->colRole.at(col).constData(),
+                           _store->deletedRole, _store->defaultScale,
+                           _store->alignment.at(col));
+
+      if (model)
+        model->blockSignals(blocked);
+
+      _store.clear();
+    }
+
+  private:
+    QSharedPointer<XTreeWidgetLazyStore> _store;
+    int  _row;
+    bool _materialized;
+};
+
+/* QTreeWidgetItem::columnCount() isn't virtual, so a lazy item reports no
+   columns until something builds it. Loops over an item's columns should
+   get the count from here.
+ */
+static int itemColumnCount(XTreeWidgetItem *item)
+{
+  XTreeWidgetLazyItem *lazy = dynamic_cast<XTreeWidgetLazyItem *>(item);
+  if (lazy)
+    lazy->materialize();
+  return item->columnCount();
+}
+
+/* A Merge populate keeps the rows already in the list and matches the new
+   result to them by key. This holds what the merge needs between the call
+   to populate() and the end of populateWorker().
+ */
+class XTreeWidgetMergeState
+{
+  public:
+    XTreeWidgetMergeState() : rebuilt(false), vscroll(0), hscroll(0) {}
+
+    QHash<QString, XTreeWidgetItem *> items;    // unmatched top-level rows
+    QList<XTreeWidgetItem *>          stale;    // rows with duplicate keys
+    QList<XTreeWidgetItem *>          order;    // top-level rows in result order
+    QSet<QString>                     expanded;
+    QSet<QString>                     selected;
+    QString                           current;
+    bool                              rebuilt;
+    int                               vscroll;
+    int                               hscroll;
+};
+
 XTreeWidget::XTreeWidget(QWidget *pParent) :
   QTreeWidget(pParent)
 {
@@ -113,6 +461,9 @@ XTreeWidget::XTreeWidget(QWidget *pParent) :
   _sord    = Qt::AscendingOrder;
   _linear  = false;
   _alwaysLinear = true;
+  _lazy    = false;
+  _keyField = -1;
+  _merge    = 0;
 
   _colIdx     = 0;  // querycol = _colIdx[xtreecol]
   _colRole    = 0;  // querycol = _colRole[xtreecol][roleid]
@@ -177,17 +528,10 @@ XTreeWidget::~XTreeWidget()
   qApp->restoreOverrideCursor();
 
   cleanupAfterPopulate();
+  clearSubtotals();
 
-  if (_subtotals)
-  {
-    for (int i = 0; i < _subtotals->size(); i++)
-    {
-      delete (*_subtotals)[i];
-      _subtotals->replace(i, 0);
-    }
-    delete _subtotals;
-    _subtotals = 0;
-  }
+  delete _merge;
+  _merge = 0;
 
   if (_x_preferences)
   {
@@ -247,11 +591,57 @@ void XTreeWidget::populate(XSqlQuery pQuery, int pIndex, bool pUseAltId, Populat
 
   pQuery.seek(-1);
 
+  /* only merge into a finished, keyed list; anything else gets rebuilt */
+  if (popstyle == Merge &&
+      (_keyColumn.isEmpty() || _roles.size() <= 0 || _merge ||
+       _workingTimer.isActive() ||
+       (topLevelItemCount() > 0 &&
+        ! topLevelItem(0)->data(0, Xt::KeyRole).isValid())))
+  {
+    popstyle = Replace;
+    args._workingPopstyle = Replace;
+  }
+
   if (popstyle == Replace)
   {
     clear();
     _workingParams.clear();
   }
+  else if (popstyle == Merge)
+  {
+    _merge = new XTreeWidgetMergeState();
+    _merge->vscroll = verticalScrollBar()->value();
+    _merge->hscroll = horizontalScrollBar()->value();
+    if (currentItem())
+      _merge->current = currentItem()->data(0, Xt::KeyRole).toString();
+
+    QList<XTreeWidgetItem *> totals;
+    for (QTreeWidgetItemIterator it(this); *it; ++it)
+    {
+      XTreeWidgetItem *item = static_cast<XTreeWidgetItem *>(*it);
+      if (item->data(0, Qt::UserRole).toString() == "totalrole")
+      {
+        totals.append(item);
+        continue;
+      }
+      QString key = item->data(0, Xt::KeyRole).toString();
+      if (item->isExpanded())
+        _merge->expanded.insert(key);
+      if (item->isSelected())
+        _merge->selected.insert(key);
+      if (! item->QTreeWidgetItem::parent())
+      {
+        if (_merge->items.contains(key))
+          _merge->stale.append(item);
+        else
+          _merge->items.insert(key, item);
+      }
+    }
+    qDeleteAll(totals); // populateCalculatedColumns() adds a fresh one
+
+    clearSubtotals();
+    _workingParams.clear();
+  }
   _workingParams.append(args);
 
   _linear = _alwaysLinear;
@@ -358,6 +748,21 @@ void XTreeWidget::populateWorker()
       if (_rowRole[ROWROLE_DELETED] < 0)
         _rowRole[ROWROLE_DELETED] = 0;
 
+      _keyField = _keyColumn.isEmpty() ? -1 : currRecord.indexOf(_keyColumn);
+
+      /* only flat lists merge row by row. indented lists, or results
+         without the key, get rebuilt and have their state put back after.
+       */
+      if (_merge && (_rowRole[ROWROLE_INDENT] || _keyField < 0))
+      {
+        if (DEBUG)
+          qDebug("%s::populate() can't merge, rebuilding", qPrintable(objectName()));
+        _merge->items.clear();
+        _merge->stale.clear();
+        _merge->rebuilt = true;
+        QTreeWidget::clear();
+      }
+
       // keep synchronized with #define COLROLE_* above
       // TODO: get rid of COLROLE_* above and replace this QStringList
       // with a map or vector of known roles and their Qt:: role or Xt
@@ -430,6 +835,54 @@ void XTreeWidget::populateWorker()
       else
         setIndentation( 0);
 
+      /* lazy populate only handles flat lists whose cells don't depend on
+         the rows around them. indented, running and totaled lists still
+         build every item up front.
+       */
+      bool lazy = _lazy && ! _rowRole[ROWROLE_INDENT] && _keyField < 0;
+      for (int wcol = 0; lazy && wcol < _roles.size(); wcol++)
+        lazy = ! (*_colRole)[wcol][COLROLE_RUNNING] &&
+               ! (*_colRole)[wcol][COLROLE_TOTAL];
+      if (lazy)
+      {
+        _lazyStore = QSharedPointer<XTreeWidgetLazyStore>(new XTreeWidgetLazyStore());
+        _lazyStore->slot         = QVector<int>(_fieldCount, -1);
+        _lazyStore->colIdx       = *_colIdx;
+        _lazyStore->deletedRole  = _rowRole[ROWROLE_DELETED];
+        _lazyStore->defaultScale = decimalPlaces("");
+
+        QList<int> used;
+        used << 0 << _rowRole[ROWROLE_DELETED];
+        for (int wcol = 0; wcol < _roles.size(); wcol++)
+        {
+          QVector<int> colRole(COLROLE_COUNT);
+          for (int k = 0; k < COLROLE_COUNT; k++)
+          {
+            colRole[k] = (*_colRole)[wcol][k];
+            if (colRole.at(k) > 0)
+              used << colRole.at(k);
+          }
+          _lazyStore->colRole.append(colRole);
+          _lazyStore->alignment.append(headerItem()->textAlignment(wcol));
+          used << _colIdx->at(wcol);
+        }
+
+        for (int i = 0; i < used.size(); i++)
+        {
+          int field = used.at(i);
+          if (field >= 0 && field < _fieldCount && _lazyStore->slot.at(field) < 0)
+          {
+            _lazyStore->slot[field] = _lazyStore->values.size();
+            _lazyStore->values.append(QVector<QVariant>());
+            if (pQuery.size() > 0)
+              _lazyStore->values.last().reserve(pQuery.size());
+          }
+        }
+        if (DEBUG)
+          qDebug("%s::populate() lazy, storing %d of %d fields",
+                 qPrintable(objectName()), _lazyStore->values.size(), _fieldCount);
+      }
+
       if (! _linear && ! _progress)
       {
         _progress = new XTreeWidgetProgress(this);
@@ -446,6 +899,7 @@ void XTreeWidget::populateWorker()
 
   int defaultScale = decimalPlaces("");
   int cnt = 0;
+  XTreeWidgetQueryRow currRow(pQuery);
 
   if (pQuery.at() >= 0) // if the query returned any rows at all
     do
@@ -460,6 +914,17 @@ void XTreeWidget::populateWorker()
 
       int id         = pQuery.value(0).toInt();
       int altId      = (pUseAltId) ? pQuery.value(1).toInt() : -1;
+
+      if (_lazyStore)
+      {
+        _last = new XTreeWidgetLazyItem(_lazyStore, _lazyStore->append(pQuery),
+                                        id, altId);
+        if (_rowRole[ROWROLE_HIDDEN])
+          _last->setHidden(pQuery.value(_rowRole[ROWROLE_HIDDEN]).toBool());
+        topLevelItems.append(_last);
+        continue;
+      }
+
       int indent     = 0;
       int lastindent = 0;
       if (_rowRole[ROWROLE_INDENT])
@@ -505,6 +970,9 @@ void XTreeWidget::populateWorker()
       if (_rowRole[ROWROLE_INDENT])
         _last->setData(0, Xt::IndentRole, indent);
 
+      if (_keyField >= 0)
+        _last->setData(0, Xt::KeyRole, pQuery.value(_keyField));
+
       if (_rowRole[ROWROLE_HIDDEN])
       {
         if (DEBUG)
@@ -524,87 +992,11 @@ void XTreeWidget::populateWorker()
           continue;
         }
 
-        QVariant rawValue;
-        if(_colIdx->at(col) >=0)  //#13439 optimization - only try to retrieve value if index is valid
-          rawValue = pQuery.value(_colIdx->at(col));
-
-        _last->setData(col, Xt::RawRole, rawValue);
+        populateItemColumn(_last, col, currRow, _colIdx->at(col),
+                           (*_colRole)[col], _rowRole[ROWROLE_DELETED],
+                           defaultScale, headerItem()->textAlignment(col));
 
-        // TODO: this isn't necessary for all columns so do less often?
-        int     scale        = defaultScale;
-        QString numericrole  = "";
-        if ((*_colRole)[col][COLROLE_NUMERIC])
-        {
-          // Negative NUMERIC ROLE => default for column instead of column index
-          // see above
-          if ((*_colRole)[col][COLROLE_NUMERIC] < 0)
-            scale = 0 - (*_colRole)[col][COLROLE_NUMERIC];
-          else
-          {
-            numericrole  = pQuery.value((*_colRole)[col][COLROLE_NUMERIC]).toString();
-            scale        = decimalPlaces(numericrole);
-          }
-        }
-
-        if ((*_colRole)[col][COLROLE_NUMERIC] ||
-            (*_colRole)[col][COLROLE_RUNNING] ||
-            (*_colRole)[col][COLROLE_TOTAL])
-          _last->setData(col, Xt::ScaleRole, scale);
-
-        /* if qtdisplayrole IS NULL then let the raw value shine through.
-           this allows UNIONS to do interesting things, like put dates and
-           text into the same visual column without SQL errors.
-        */
-        if ((*_colRole)[col][COLROLE_DISPLAY] &&
-            !pQuery.value((*_colRole)[col][COLROLE_DISPLAY]).isNull())
-        {
-          /* this might not handle PostgreSQL NUMERICs properly
-             but at least it will try to handle INTEGERs and DOUBLEs
-             and it will avoid formatting sales order numbers with decimal
-             and group separators
-          */
-          QVariant field = pQuery.value((*_colRole)[col][COLROLE_DISPLAY]);
-          if (field.type() == QVariant::Int)
-            _last->setData(col, Qt::DisplayRole,
-                          QLocale().toString(field.toInt()));
-          else if (field.type() == QVariant::Double)
-            _last->setData(col, Qt::DisplayRole,
-                          QLocale().toString(field.toDouble(),
-                                             'f', scale));
-          else
-            _last->setData(col, Qt::DisplayRole, field.toString());
-        }
-        else if (rawValue.isNull())
-        {
-          _last->setData(col, Qt::DisplayRole,
-                        (*_colRole)[col][COLROLE_NULL] ?
-                        pQuery.value((*_colRole)[col][COLROLE_NULL]).toString() :
-                        "");
-        }
-        else if ((*_colRole)[col][COLROLE_NUMERIC] &&
-                 ((numericrole == "percent") ||
-                  (numericrole == "scrap")))
-        {
-          _last->setData(col, Qt::DisplayRole,
-                          QLocale().toString(rawValue.toDouble() * 100.0,
-                                           'f', scale));
-        }
-        else if ((*_colRole)[col][COLROLE_NUMERIC] || rawValue.type() == QVariant::Double)
-        {
-          // Issue #8897
-          _last->setData(col, Qt::DisplayRole,
-                          QLocale().toString(round(rawValue.toDouble(), scale),
-                                           'f', scale));
-        }
-        else if (rawValue.type() == QVariant::Bool)
-        {
-          _last->setData(col, Qt::DisplayRole,
-                        rawValue.toBool() ? yesStr : noStr);
-        }
-        else
-        {
-          _last->setData(col, Qt::EditRole, rawValue);
-        }
+        QVariant rawValue = _last->data(col, Xt::RawRole);
 
         if (indent)
         {
@@ -622,64 +1014,6 @@ void XTreeWidget::populateWorker()
                     qPrintable( rawValue.toString()));
         }
 
-        if ((*_colRole)[col][COLROLE_FOREGROUND])
-        {
-          QVariant fg = pQuery.value((*_colRole)[col][COLROLE_FOREGROUND]);
-          if (!fg.isNull())
-            _last->setData(col, Qt::ForegroundRole, namedColor(fg.toString()));
-        }
-
-        if ((*_colRole)[col][COLROLE_BACKGROUND])
-        {
-          QVariant bg = pQuery.value((*_colRole)[col][COLROLE_BACKGROUND]);
-          if (!bg.isNull())
-            _last->setData(col, Qt::BackgroundRole, namedColor(bg.toString()));
-        }
-
-        if ((*_colRole)[col][COLROLE_TEXTALIGNMENT])
-        {
-          QVariant alignment = pQuery.value((*_colRole)[col][COLROLE_TEXTALIGNMENT]);
-          if (!alignment.isNull())
-            _last->setData(col, Qt::TextAlignmentRole, alignment);
-        }
-        else
-          _last->setData(col, Qt::TextAlignmentRole, headerItem()->textAlignment(col));
-
-        if ((*_colRole)[col][COLROLE_TOOLTIP])
-        {
-          QVariant tooltip = pQuery.value((*_colRole)[col][COLROLE_TOOLTIP]);
-          if (!tooltip.isNull() )
-            _last->setData(col, Qt::ToolTipRole, tooltip);
-        }
-
-        if ((*_colRole)[col][COLROLE_STATUSTIP])
-        {
-          QVariant statustip = pQuery.value((*_colRole)[col][COLROLE_STATUSTIP]);
-          if (!statustip.isNull())
-            _last->setData(col, Qt::StatusTipRole, statustip);
-        }
-
-        if ((*_colRole)[col][COLROLE_FONT])
-        {
-          QVariant font = pQuery.value((*_colRole)[col][COLROLE_FONT]);
-          if (!font.isNull())
-            _last->setData(col, Qt::FontRole, font);
-        }
-
-        if ((*_colRole)[col][COLROLE_RUNNINGINIT])
-        {
-          QVariant runninginit = pQuery.value((*_colRole)[col][COLROLE_RUNNINGINIT]);
-          if (!runninginit.isNull())
-            _last->setData(col, Xt::RunningInitRole, runninginit);
-        }
-
-        if ((*_colRole)[col][COLROLE_ID])
-        {
-          QVariant id = pQuery.value((*_colRole)[col][COLROLE_ID]);
-          if (!id.isNull())
-            _last->setData(col, Xt::IdRole, id);
-        }
-
         if ((*_colRole)[col][COLROLE_RUNNING])
         {
           int set = pQuery.value((*_colRole)[col][COLROLE_RUNNING]).toInt();
@@ -695,36 +1029,9 @@ void XTreeWidget::populateWorker()
           }
           (*(*_subtotals)[col])[set] += rawValue.toDouble();
           _last->setData(col, Qt::DisplayRole,
-                         QLocale().toString((*_subtotals)[col]->value(set), 'f', scale));
-        }
-
-        if ((*_colRole)[col][COLROLE_TOTAL])
-        {
-          _last->setData(col, Xt::TotalSetRole,
-                        pQuery.value((*_colRole)[col][COLROLE_TOTAL]).toInt());
-        }
-
-        if (_rowRole[ROWROLE_DELETED])
-        {
-          if (DEBUG)
-            qDebug("%s::populate() found xtdeleterole, value = %s",
-                    qPrintable( objectName()),
-                    qPrintable( pQuery.value(_rowRole[ROWROLE_DELETED]).toString()));
-          if (pQuery.value(_rowRole[ROWROLE_DELETED]).toBool())
-          {
-            _last->setData(col,Xt::DeletedRole, QVariant(true));
-            QFont font = _last->font(col);
-            font.setStrikeOut(true);
-            _last->setFont(col, font);
-            _last->setTextColor(Qt::gray);
-          }
+                         QLocale().toString((*_subtotals)[col]->value(set), 'f',
+                                            _last->data(col, Xt::ScaleRole).toInt()));
         }
-        /*
-        if ((*_colRole)[col][COLROLE_KEY])
-          _last->setData(col, KeyRole, pQuery.value((*_colRole)[col][COLROLE_KEY]));
-        if ((*_colRole)[col][COLROLE_GROUPRUNNING])
-          _last->setData(col, GroupRunningRole, pQuery.value((*_colRole)[col][COLROLE_GROUPRUNNING]));
-        */
       }
 
       if (allNull && indent > 0)
@@ -738,7 +1045,18 @@ void XTreeWidget::populateWorker()
       {
         //#13439 optimization - do not add items to 'this' until the very end
         if(parentItem == this)
-          topLevelItems.append(_last);
+        {
+          XTreeWidgetItem *kept = 0;
+          if (_merge)
+            kept = mergeTopLevelItem(_last, _rowRole[ROWROLE_HIDDEN] &&
+                                            pQuery.value(_rowRole[ROWROLE_HIDDEN]).toBool());
+          if (kept)
+            _last = kept;
+          else
+            topLevelItems.append(_last);
+          if (_merge)
+            _merge->order.append(_last);
+        }
         else
           qobject_cast<XTreeWidget*>(parentItem)->addTopLevelItem(_last);
       }
@@ -749,7 +1067,8 @@ void XTreeWidget::populateWorker()
 
   this->addTopLevelItems(topLevelItems); //#13439
 
-  setId(pIndex);
+  if (! _merge)
+    setId(pIndex);
   emit valid(currentItem() != 0);
 
   // clean up. we won't reach here until the query is done, even if ! _linear
@@ -761,6 +1080,9 @@ void XTreeWidget::populateWorker()
 
     cleanupAfterPopulate();
 
+    if (_merge)
+      finishMerge();
+
     populateCalculatedColumns();
     if (sortColumn() >= 0 && header()->isSortIndicatorShown())
       sortItems(sortColumn(), header()->sortIndicatorOrder());
@@ -783,6 +1105,8 @@ void XTreeWidget::cleanupAfterPopulate()
     _rowRole[i] = 0;
 
   _last = 0;
+  _keyField = -1;
+  _lazyStore.clear();
 
   // TODO: get rid of this when the code is rewritten
   //       as per above's todo about the QVector<int*>
@@ -804,6 +1128,120 @@ void XTreeWidget::cleanupAfterPopulate()
   _fieldCount = 0;
 }
 
+void XTreeWidget::clearSubtotals()
+{
+  if (_subtotals)
+  {
+    for (int i = 0; i < _subtotals->size(); i++)
+    {
+      delete (*_subtotals)[i];
+      _subtotals->replace(i, 0);
+    }
+    delete _subtotals;
+    _subtotals = 0;
+  }
+}
+
+/* Match a freshly built top-level row to the row with the same key from
+   the previous populate. The old row stays where it is, keeping its
+   selection and children, and takes on the new values only if something
+   visible changed. Returns the old row, or 0 if \a fresh is a new row.
+ */
+XTreeWidgetItem *XTreeWidget::mergeTopLevelItem(XTreeWidgetItem *fresh, bool hidden)
+{
+  XTreeWidgetItem *existing = _merge->items.take(fresh->data(0, Xt::KeyRole).toString());
+  if (! existing)
+    return 0;
+
+  bool same = existing->id() == fresh->id() && existing->altId() == fresh->altId();
+  for (int col = 0; same && col < columnCount(); col++)
+  {
+    same = existing->data(col, Qt::DisplayRole)    == fresh->data(col, Qt::DisplayRole)    &&
+           existing->data(col, Xt::RawRole)        == fresh->data(col, Xt::RawRole)        &&
+           existing->data(col, Qt::ForegroundRole) == fresh->data(col, Qt::ForegroundRole) &&
+           existing->data(col, Qt::BackgroundRole) == fresh->data(col, Qt::BackgroundRole) &&
+           existing->data(col, Qt::FontRole)       == fresh->data(col, Qt::FontRole)       &&
+           existing->data(col, Qt::ToolTipRole)    == fresh->data(col, Qt::ToolTipRole);
+  }
+
+  if (! same)
+  {
+    existing->QTreeWidgetItem::operator=(*fresh);
+    existing->setId(fresh->id());
+    existing->setAltId(fresh->altId());
+    existing->emitDataChanged();
+  }
+  if (existing->isHidden() != hidden)
+    existing->setHidden(hidden);
+
+  delete fresh;
+  return existing;
+}
+
+/* Drop the rows that weren't in the new result and put the rest in the
+   order the query returned them, moving only the rows that are out of
+   place. If the list had to be rebuilt instead of merged, put back what
+   was expanded and selected.
+ */
+void XTreeWidget::finishMerge()
+{
+  qDeleteAll(_merge->items);
+  qDeleteAll(_merge->stale);
+  _merge->items.clear();
+  _merge->stale.clear();
+
+  /* sortItems() reorders everything anyway if there's a sort indicator */
+  if (! _merge->rebuilt &&
+      ! (sortColumn() >= 0 && header()->isSortIndicatorShown()))
+  {
+    for (int row = 0; row < _merge->order.size(); row++)
+    {
+      XTreeWidgetItem *item = _merge->order.at(row);
+      int from = indexOfTopLevelItem(item);
+      if (from == row || from < 0)
+        continue;
+
+      /* the view forgets these when the item leaves the tree */
+      bool current  = currentItem() == item;
+      bool selected = item->isSelected();
+      bool expanded = item->isExpanded();
+      bool hidden   = item->isHidden();
+
+      takeTopLevelItem(from);
+      insertTopLevelItem(row, item);
+
+      if (hidden)
+        item->setHidden(true);
+      if (expanded)
+        item->setExpanded(true);
+      if (current)
+        QTreeWidget::setCurrentItem(item, 0, QItemSelectionModel::NoUpdate);
+      if (selected)
+        item->setSelected(true);
+    }
+  }
+
+  if (_merge->rebuilt)
+  {
+    for (QTreeWidgetItemIterator it(this); *it; ++it)
+    {
+      QString key = (*it)->data(0, Xt::KeyRole).toString();
+      if (_merge->expanded.contains(key))
+        (*it)->setExpanded(true);
+      if (key == _merge->current)
+        QTreeWidget::setCurrentItem(*it, 0, QItemSelectionModel::NoUpdate);
+      if (_merge->selected.contains(key))
+        (*it)->setSelected(true);
+    }
+  }
+
+  verticalScrollBar()->setValue(_merge->vscroll);
+  horizontalScrollBar()->setValue(_merge->hscroll);
+
+  delete _merge;
+  _merge = 0;
+}
+
 void XTreeWidget::addColumn(const QString &pString, int pWidth, int pAlignment, bool pVisible, const QString pEditColumn, const QString pDisplayColumn, const int scale)
 {
   if (!_settingsLoaded)
@@ -1415,22 +1853,42 @@ void XTreeWidget::setPopulateLinear(bool alwaysLinear)
   _alwaysLinear = alwaysLinear;
 }
 
+/*!
+  When \a lazy is true, populate() keeps a compact copy of the query
+  results and only builds the display roles of each row when that row is
+  first shown, exported or otherwise read. This keeps load time and memory
+  proportional to what the user looks at rather than to the result size.
+  Lists that use xtindentrole, xtrunningrole or xttotalrole are always
+  populated in full.
+*/
+bool XTreeWidget::populateLazy() { return _lazy; }
+void XTreeWidget::setPopulateLazy(bool lazy)
+{
+  _lazy = lazy;
+}
+
+/*!
+  The \a column names a query result column that uniquely identifies each
+  row. populate() records its value on every row so a later populate
+  with the Merge style can update, add and remove rows in place instead
+  of rebuilding the list, keeping the selection, scroll position and
+  expanded rows. Setting a key column turns off lazy populate.
+*/
+QString XTreeWidget::keyColumn() const { return _keyColumn; }
+void XTreeWidget::setKeyColumn(const QString &column)
+{
+  _keyColumn = column;
+}
+
 void XTreeWidget::clear()
 {
   if (DEBUG)
     qDebug("%s::clear()", qPrintable(objectName()));
   if (! _workingTimer.isActive())
     _workingParams.clear();
-  if (_subtotals)
-  {
-    for (int i = 0; i < _subtotals->size(); i++)
-    {
-      delete (*_subtotals)[i];
-      _subtotals->replace(i, 0);
-    }
-    delete _subtotals;
-    _subtotals = 0;
-  }
+  clearSubtotals();
+  delete _merge;
+  _merge = 0;
   emit valid(false);
   _savedId = false; // was -1;
 
@@ -1580,24 +2038,40 @@ void XTreeWidget::sExport()
 
   if (!fi.filePath().isEmpty())
   {
-    QTextDocument       *doc = new QTextDocument();
-    QTextDocumentWriter writer;
     if (fi.suffix().isEmpty())
       fi.setFile(fi.filePath() += defaultSuffix);
     xtsettingsSetValue(_settingsName + "/exportPath", fi.path());
-    writer.setFileName(fi.filePath());
 
-    if (fi.suffix() == "txt")
+    // stream the row-oriented formats straight to disk
+    if (fi.suffix() == "txt" || fi.suffix() == "csv" || fi.suffix() == "html")
     {
-      doc->setPlainText(toTxt());
-      writer.setFormat("plaintext");
-    }
-    else if (fi.suffix() == "csv")
-    {
-      doc->setPlainText(toCsv());
-      writer.setFormat("plaintext");
+      ExportFormat format = ExportTxt;
+      if (fi.suffix() == "csv")
+        format = ExportCsv;
+      else if (fi.suffix() == "html")
+        format = ExportHtml;
+
+      QFile file(fi.filePath());
+      if (! file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      {
+        QMessageBox::warning(this, tr("Export Failed"),
+                             tr("Could not open %1 for writing: %2")
+                               .arg(fi.filePath(), file.errorString()));
+        return;
+      }
+      if (! exportToDevice(&file, format))
+      {
+        file.close();
+        file.remove();
+      }
+      return;
     }
-    else if (fi.suffix() == "vcf")
+
+    QTextDocument       *doc = new QTextDocument();
+    QTextDocumentWriter writer;
+    writer.setFileName(fi.filePath());
+
+    if (fi.suffix() == "vcf")
     {
       doc->setPlainText(toVcf());
       writer.setFormat("plaintext");
@@ -1607,11 +2081,6 @@ void XTreeWidget::sExport()
       doc->setHtml(toHtml());
       writer.setFormat("odf");
     }
-    else if (fi.suffix() == "html")
-    {
-      doc->setHtml(toHtml());
-      writer.setFormat("HTML");
-    }
     writer.write(doc);
   }
 }
@@ -2212,7 +2681,8 @@ void XTreeWidget::sCopyRowToClipboard()
   if (_x_preferences->boolean("CopyListsPlainText"))
   {
     QString line = "";
-    for (int counter = 0; counter < item->columnCount(); counter++)
+    int columns = itemColumnCount(item);
+    for (int counter = 0; counter < columns; counter++)
     {
       if (!QTreeWidget::isColumnHidden(counter))
         line = line + item->text(counter) + "\t";
@@ -2224,7 +2694,8 @@ void XTreeWidget::sCopyRowToClipboard()
   cursor->insertTable(1, 1,tableFormat);
   if (item)
   {
-    for (counter = 0; counter < item->columnCount(); counter++)
+    int columns = itemColumnCount(item);
+    for (counter = 0; counter < columns; counter++)
     {
       if (!QTreeWidget::isColumnHidden(counter))
       {
@@ -2344,88 +2815,213 @@ void XTreeWidget::sSearch(const QString &pTarget)
 
 QString XTreeWidget::toTxt() const
 {
-  QString line;
   QString opText;
-  int     counter;
+  QTextStream ts(&opText);
+  writeExport(ts, ExportTxt, 0);
+  ts.flush();
+  return opText;
+}
+
+QString XTreeWidget::toCsv() const
+{
+  QString opText;
+  QTextStream ts(&opText);
+  writeExport(ts, ExportCsv, 0);
+  ts.flush();
+  return opText;
+}
+
+QString XTreeWidget::exportHeader(ExportFormat format) const
+{
+  QString line;
+  int     colcount = 0;
 
   QTreeWidgetItem *header = headerItem();
-  for (counter = 0; counter < header->columnCount(); counter++)
+  for (int counter = 0; counter < header->columnCount(); counter++)
   {
-    if (!QTreeWidget::isColumnHidden(counter))
-      line = line + header->text(counter).replace("\r\n"," ") + "\t";
-  }
-  opText = line + "\r\n";
+    if (QTreeWidget::isColumnHidden(counter))
+      continue;
 
-  XTreeWidgetItem *item = topLevelItem(0);
-  if (item)
-  {
-    for (QModelIndex idx = indexFromItem(item); idx.isValid(); idx = indexBelow(idx))
+    if (format == ExportTxt)
+      line = line + header->text(counter).replace("\r\n"," ") + "\t";
+    else if (format == ExportCsv)
     {
-      item = (XTreeWidgetItem *)itemFromIndex(idx);
-      if (item)
-      {
-        line = "";
-        for (counter = 0; counter < item->columnCount(); counter++)
-        {
-          if (!QTreeWidget::isColumnHidden(counter))
-            line = line + item->text(counter) + "\t";
-        }
-      }
-      opText = opText + line + "\r\n";
+      if (colcount)
+        line = line + ",";
+      line = line + header->text(counter).replace("\"","\"\"").replace("\r\n"," ").replace("\n"," ");
     }
+    else if (format == ExportHtml)
+      line = line + "<th style=\"background-color: #d3d3d3\">"
+                  + header->text(counter).toHtmlEscaped() + "</th>";
+    colcount++;
   }
-  return opText;
+
+  if (format == ExportHtml)
+    line = "<tr>" + line + "</tr>";
+  return line;
 }
 
-QString XTreeWidget::toCsv() const
+QString XTreeWidget::exportLine(XTreeWidgetItem *item, ExportFormat format) const
 {
   QString line;
-  QString opText;
-  int     counter;
-  int     colcount         = 0;
+  int     colcount = 0;
+  int     columns  = itemColumnCount(item);
 
-  QTreeWidgetItem *header  = headerItem();
-  for (counter = 0; counter < header->columnCount(); counter++)
+  for (int counter = 0; counter < columns; counter++)
   {
-    if (!QTreeWidget::isColumnHidden(counter))
+    if (QTreeWidget::isColumnHidden(counter))
+      continue;
+
+    if (format == ExportTxt)
+      line = line + item->text(counter) + "\t";
+    else if (format == ExportCsv)
     {
       if (colcount)
         line = line + ",";
-      line = line + header->text(counter).replace("\"","\"\"").replace("\r\n"," ").replace("\n"," ");
-      colcount++;
+      if (item->data(counter,Qt::DisplayRole).type() == QVariant::String)
+        line = line + "\"";
+      line = line + item->text(counter).replace("\"","\"\"");
+      if (item->data(counter,Qt::DisplayRole).type() == QVariant::String)
+        line = line + "\"";
+    }
+    else if (format == ExportHtml)
+    {
+      QStringList style;
+      if (item->data(counter, Qt::BackgroundRole).isValid())
+        style << "background-color: " + item->data(counter, Qt::BackgroundRole).value<QColor>().name();
+      if (item->data(counter, Qt::ForegroundRole).isValid())
+        style << "color: " + item->data(counter, Qt::ForegroundRole).value<QColor>().name();
+      if (style.isEmpty())
+        line = line + "<td>";
+      else
+        line = line + "<td style=\"" + style.join("; ") + "\">";
+      line = line + item->text(counter).toHtmlEscaped() + "</td>";
+    }
+    colcount++;
+  }
+
+  if (format == ExportHtml)
+    line = "<tr>" + line + "</tr>";
+  return line;
+}
+
+/* Exported files used to go through QTextDocument::setPlainText() and
+   toPlainText(), which turn every line break into LF and non-breaking
+   spaces, like some locales' group separator, into plain spaces. Do the
+   same so saved CSV and text files don't change.
+ */
+static QString plainTextDocument(const QString &text)
+{
+  QString result(text);
+  result.replace("\r\n", "\n");
+  for (QChar *c = result.data(), *end = c + result.size(); c != end; ++c)
+  {
+    switch (c->unicode())
+    {
+      case '\r':
+      case 0xfdd0: // QTextBeginningOfFrame
+      case 0xfdd1: // QTextEndOfFrame
+      case QChar::ParagraphSeparator:
+      case QChar::LineSeparator:
+        *c = QLatin1Char('\n');
+        break;
+      case QChar::Nbsp:
+        *c = QLatin1Char(' ');
+        break;
+      default:
+        break;
     }
   }
-  opText = line + "\r\n";
+  return result;
+}
+
+/* Write the visible rows one line at a time so the caller decides where the
+   text goes. Returns false if the user cancelled from \a progress. If
+   \a plainText is set, CSV and text lines are written the way
+   QTextDocument's plain text writer would write them.
+ */
+bool XTreeWidget::writeExport(QTextStream &ts, ExportFormat format, QProgressDialog *progress, bool plainText) const
+{
+  plainText = plainText && format != ExportHtml;
+  const char *eol = (format == ExportHtml || plainText) ? "\n" : "\r\n";
+
+  if (format == ExportHtml)
+    ts << "<html>\n<head><meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\"/></head>\n"
+       << "<body>\n<table border=\"1\" cellspacing=\"0\" cellpadding=\"2\">\n";
+
+  if (plainText)
+    ts << plainTextDocument(exportHeader(format)) << eol;
+  else
+    ts << exportHeader(format) << eol;
 
+  QString line;
+  int     row  = 0;
   XTreeWidgetItem *item = topLevelItem(0);
   if (item)
   {
-    for (QModelIndex idx = indexFromItem(item); idx.isValid(); idx = indexBelow(idx))
+    for (QModelIndex idx = indexFromItem(item); idx.isValid(); idx = indexBelow(idx), row++)
     {
-      colcount = 0;
-      item     = (XTreeWidgetItem *)itemFromIndex(idx);
+      item = (XTreeWidgetItem *)itemFromIndex(idx);
       if (item)
+        line = exportLine(item, format);
+      if (plainText)
+        ts << plainTextDocument(line) << eol;
+      else
+        ts << line << eol;
+
+      if (progress && row % EXPORTROWS == 0)
       {
-        line = "";
-        for (counter = 0; counter < item->columnCount(); counter++)
-        {
-          if (!QTreeWidget::isColumnHidden(counter))
-          {
-            if (colcount)
-              line = line + ",";
-            if (item->data(counter,Qt::DisplayRole).type() == QVariant::String)
-              line = line + "\"";
-            line = line + item->text(counter).replace("\"","\"\"");
-            if (item->data(counter,Qt::DisplayRole).type() == QVariant::String)
-              line = line + "\"";
-            colcount++;
-          }
-        }
+        ts.flush();
+        progress->setValue(row);
+        if (progress->wasCanceled())
+          return false;
       }
-      opText = opText + line + "\r\n";
     }
   }
-  return opText;
+
+  if (format == ExportHtml)
+    ts << "</table>\n</body>\n</html>\n";
+
+  if (progress)
+    progress->setValue(progress->maximum());
+  return true;
+}
+
+/*!
+  Write the visible rows of the list to \a device in the given \a format
+  without building the whole document in memory first. The CSV and text
+  output is what sExport() has always saved: the text of toCsv() or toTxt()
+  with LF line endings and non-breaking spaces written as plain spaces.
+
+  If \a showProgress is true then a progress dialog lets the user cancel
+  the export, in which case exportToDevice() returns false and whatever
+  was already written stays on \a device.
+*/
+bool XTreeWidget::exportToDevice(QIODevice *device, ExportFormat format, bool showProgress)
+{
+  if (! device || ! device->isWritable())
+    return false;
+
+  QTextStream ts(device);
+  ts.setCodec("UTF-8");
+
+  QProgressDialog *progress = 0;
+  if (showProgress)
+  {
+    int rowcnt = 0;
+    for (QModelIndex idx = indexFromItem(topLevelItem(0)); idx.isValid(); idx = indexBelow(idx))
+      rowcnt++;
+    progress = new QProgressDialog(tr("Exporting..."), tr("Cancel"), 0, rowcnt, this);
+    progress->setWindowModality(Qt::WindowModal);
+  }
+
+  bool result = writeExport(ts, format, progress, true);
+  ts.flush();
+
+  if (progress)
+    delete progress;
+
+  return result;
 }
 
 QString XTreeWidget::toVcf() const
@@ -2594,7 +3190,8 @@ QString XTreeWidget::toHtml() const
       item = (XTreeWidgetItem *)itemFromIndex(idx);
       if (item)
       {
-        for (int counter = 0; counter < item->columnCount(); counter++)
+        int columns = itemColumnCount(item);
+        for (int counter = 0; counter < columns; counter++)
         {
           if (!QTreeWidget::isColumnHidden(counter))
           {
@@ -13,6 +13,7 @@
 
 #include <QTreeWidget>
 #include <QTreeWidgetItem>
+#include <QSharedPointer>
 #include <QVariant>
 #include <QVector>
 #include <QTimer>
@@ -54,7 +55,10 @@
 #include "xsqlquery.h"
 
 class QAction;
+class QIODevice;
 class QMenu;
+class QProgressDialog;
+class QTextStream;
 class QScriptEngine;
 class XTreeWidget;
 class XTreeWidgetProgress;
@@ -158,6 +162,8 @@ class XTUPLEWIDGETS_EXPORT XTreeWidgetItem : public QObject, public QTreeWidgetI
     int _altId;
 };
 
+class XTreeWidgetLazyStore;
+class XTreeWidgetMergeState;
 class XTreeWidgetPopulateParams;
 
 class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
@@ -165,10 +171,14 @@ class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
   Q_OBJECT Q_PROPERTY(QString dragString READ dragString WRITE setDragString)
   Q_PROPERTY( QString altDragString READ altDragString WRITE setAltDragString)
   Q_PROPERTY( bool populateLinear READ populateLinear WRITE setPopulateLinear)
+  Q_PROPERTY( bool populateLazy   READ populateLazy   WRITE setPopulateLazy)
+  Q_PROPERTY( QString keyColumn   READ keyColumn      WRITE setKeyColumn)
 
   public :
-    enum PopulateStyle { Replace, Append };
+    enum PopulateStyle { Replace, Append, Merge };
     Q_ENUM(PopulateStyle)
+    enum ExportFormat { ExportCsv, ExportTxt, ExportHtml };
+    Q_ENUM(ExportFormat)
 
     XTreeWidget(QWidget *);
     ~XTreeWidget();
@@ -184,6 +194,10 @@ class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
     void    setAltDragString(QString);
     bool    populateLinear();
     void    setPopulateLinear(bool alwaysLinear = true);
+    bool    populateLazy();
+    void    setPopulateLazy(bool lazy = true);
+    QString keyColumn() const;
+    void    setKeyColumn(const QString &column);
 
     Q_INVOKABLE int   altId() const;
     Q_INVOKABLE int   id()    const;
@@ -206,6 +220,7 @@ class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
     Q_INVOKABLE QString toCsv() const;
     Q_INVOKABLE QString toVcf() const;
     Q_INVOKABLE QString toHtml() const;
+    bool    exportToDevice(QIODevice *device, ExportFormat format = ExportCsv, bool showProgress = true);
 
     // just for scripting exposure:
     Q_INVOKABLE inline void addTopLevelItem(XTreeWidgetItem *item) {        QTreeWidget::addTopLevelItem(item); }
@@ -327,6 +342,11 @@ class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
     QTimer        _workingTimer;
     bool          _alwaysLinear;
     bool          _linear;
+    bool          _lazy;
+    QSharedPointer<XTreeWidgetLazyStore> _lazyStore;
+    QString       _keyColumn;
+    int           _keyField;
+    XTreeWidgetMergeState *_merge;
 
     QVector<int>    *_colIdx;
     QVector<int *>  *_colRole;
@@ -334,6 +354,12 @@ class XTUPLEWIDGETS_EXPORT XTreeWidget : public QTreeWidget
     XTreeWidgetItem *_last;
     int              _rowRole[ROWROLE_COUNT];
     void             cleanupAfterPopulate();
+    void             clearSubtotals();
+    XTreeWidgetItem *mergeTopLevelItem(XTreeWidgetItem *fresh, bool hidden);
+    void             finishMerge();
+    QString          exportHeader(ExportFormat format) const;
+    QString          exportLine(XTreeWidgetItem *item, ExportFormat format) const;
+    bool             writeExport(QTextStream &ts, ExportFormat format, QProgressDialog *progress, bool plainText = false) const;
     XTreeWidgetProgress *_progress;
     QList<QMap<int, double> *> *_subtotals;
 
@@ -12,6 +12,7 @@ SUBDIRS = common \
           scriptapi \
           widgets/dll.pro \
           widgets \
-          guiclient
+          guiclient \
+          test
 
 CONFIG += ordered